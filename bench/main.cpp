@@ -21,6 +21,20 @@ mr::Matr4f m2 {
   mr::Matr4f::RowT{a, 3, 2, 1}
 };
 
+// invertible matrices
+template <typename T>
+mr::Matr4<T> rigid_matr() {
+  return mr::Matr4<T>::rotate({T(a), 1, 1}, mr::Radians<T>(a)) * mr::Matr4<T>::translate({30, 47, 80});
+}
+
+template <typename T>
+mr::Matr4<T> affine_matr() {
+  return mr::Matr4<T>::scale({2, T(a), 3}) * rigid_matr<T>();
+}
+
+mr::Matr4f m_rigid = rigid_matr<float>();
+mr::Matr4f m_affine = affine_matr<float>();
+
 mr::Camera<float> cam {};
 
 static void BM_camera_perspective(benchmark::State& state) {
@@ -87,6 +101,52 @@ static void BM_vector_matrix_multiplication(benchmark::State& state) {
 }
 BENCHMARK(BM_vector_matrix_multiplication);
 
+static void BM_transform_points(benchmark::State& state) {
+  std::vector<mr::Vec3f> in(state.range(0), v1 + v2 + v3);
+  std::vector<mr::Vec3f> out(state.range(0));
+  for (auto _ : state) {
+    mr::transform_points(in, m1, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_transform_points)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_transform_points_loop(benchmark::State& state) {
+  std::vector<mr::Vec3f> in(state.range(0), v1 + v2 + v3);
+  std::vector<mr::Vec3f> out(state.range(0));
+  for (auto _ : state) {
+    for (size_t i = 0; i < in.size(); i++) {
+      out[i] = in[i] * m1;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_transform_points_loop)->Arg(1 << 10)->Arg(1 << 16);
+
+template <mr::Isa I>
+static void BM_transform_points_isa(benchmark::State& state) {
+  if (!mr::force_isa(I)) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+  std::vector<mr::Vec3f> in(state.range(0), v1 + v2 + v3);
+  std::vector<mr::Vec3f> out(state.range(0));
+  for (auto _ : state) {
+    mr::transform_points(in, m1, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  mr::reset_isa();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_transform_points_isa<mr::Isa::generic>)->Arg(1 << 16);
+BENCHMARK(BM_transform_points_isa<mr::Isa::avx2>)->Arg(1 << 16);
+BENCHMARK(BM_transform_points_isa<mr::Isa::avx512>)->Arg(1 << 16);
+
 static void BM_normalized(benchmark::State& state) {
   for (auto _ : state) {
     auto v3 = v1.normalized();
@@ -103,6 +163,241 @@ static void BM_normalized_fast(benchmark::State& state) {
 }
 BENCHMARK(BM_normalized_fast);
 
+template <mr::RsqrtPrecision P>
+static void BM_rsqrt_batch(benchmark::State& state) {
+  std::vector<float> in(state.range(0), 14.f), out(state.range(0));
+  for (auto _ : state) {
+    mr::rsqrt<P>(in, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rsqrt_batch<mr::RsqrtPrecision::estimate>)->Arg(1 << 16);
+BENCHMARK(BM_rsqrt_batch<mr::RsqrtPrecision::newton1>)->Arg(1 << 16);
+BENCHMARK(BM_rsqrt_batch<mr::RsqrtPrecision::newton2>)->Arg(1 << 16);
+BENCHMARK(BM_rsqrt_batch<mr::RsqrtPrecision::exact>)->Arg(1 << 16);
+
+static void BM_stream_normalize(benchmark::State& state) {
+  std::vector<mr::Vec3f> vecs(state.range(0), v1 + v2 + v3);
+  mr::VecStream3f stream {vecs};
+  for (auto _ : state) {
+    stream.normalize();
+    benchmark::DoNotOptimize(stream);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_stream_normalize)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_stream_normalize_loop(benchmark::State& state) {
+  std::vector<mr::Vec3f> vecs(state.range(0), v1 + v2 + v3);
+  for (auto _ : state) {
+    for (auto &v : vecs) {
+      v.normalize();
+    }
+    benchmark::DoNotOptimize(vecs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_stream_normalize_loop)->Arg(1 << 10)->Arg(1 << 16);
+
+template <mr::Isa I>
+static void BM_stream_dispatch(benchmark::State& state) {
+  if (!mr::force_isa(I)) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+  std::vector<mr::Vec3f> vecs(state.range(0), v1 + v2 + v3);
+  mr::VecStream3f stream {vecs};
+  for (auto _ : state) {
+    stream.transform_directions(m1);
+    stream.normalize_fast();
+    benchmark::DoNotOptimize(stream);
+  }
+  mr::reset_isa();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_stream_dispatch<mr::Isa::generic>)->Arg(1 << 16);
+BENCHMARK(BM_stream_dispatch<mr::Isa::sse42>)->Arg(1 << 16);
+BENCHMARK(BM_stream_dispatch<mr::Isa::avx2>)->Arg(1 << 16);
+BENCHMARK(BM_stream_dispatch<mr::Isa::avx512>)->Arg(1 << 16);
+
+static void BM_swizzle(benchmark::State& state) {
+  for (auto _ : state) {
+    auto v = v1.zxy();
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_swizzle);
+
+static void BM_swizzle_loop(benchmark::State& state) {
+  for (auto _ : state) {
+    auto v = mr::Vec3f(v1.z(), v1.x(), v1.y());
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_swizzle_loop);
+
+static void BM_color_convert(benchmark::State& state) {
+  std::vector<mr::Color> colors(state.range(0), mr::Color(0.1f, 0.2f, a, 0.4f));
+  std::vector<mr::Vec4f> out(colors.size());
+  for (auto _ : state) {
+    mr::Color::argb(colors, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_color_convert)->Arg(1 << 16);
+
+static void BM_color_convert_loop(benchmark::State& state) {
+  std::vector<mr::Color> colors(state.range(0), mr::Color(0.1f, 0.2f, a, 0.4f));
+  std::vector<mr::Vec4f> out(colors.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < colors.size(); i++) {
+      out[i] = mr::Vec4f(colors[i].a(), colors[i].r(), colors[i].g(), colors[i].b());
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_color_convert_loop)->Arg(1 << 16);
+
+static void BM_half_convert(benchmark::State& state) {
+  std::vector<mr::Vec3h> in(state.range(0), mr::Vec3h(1, 2, 3));
+  std::vector<mr::Vec3f> out(state.range(0));
+  for (auto _ : state) {
+    mr::convert(in, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_half_convert)->Arg(1 << 16);
+
+static std::vector<mr::Norm3f> sphere_normals(size_t count) {
+  std::vector<mr::Norm3f> normals;
+  normals.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const float z = 1 - (2 * i + 1.f) / count;
+    const float r = std::sqrt(1 - z * z);
+    normals.emplace_back(r * std::cos(i * 2.39996323f), r * std::sin(i * 2.39996323f), z);
+  }
+  return normals;
+}
+
+// reports maximum angular error (degrees) of the round trip
+static void max_oct_error(benchmark::State& state, std::span<const mr::Norm3f> normals, std::span<const mr::Norm3f> decoded) {
+  double error = 0;
+  for (size_t i = 0; i < normals.size(); i++) {
+    const mr::Vec3d a = mr::Vec3f(normals[i]), b = mr::Vec3f(decoded[i]);
+    error = std::max(error, std::atan2(a.cross(b).length(), a.dot(b)));
+  }
+  state.counters["max_error_deg"] = error * 180 / std::numbers::pi;
+}
+
+template <size_t Bits>
+static void BM_oct_encode(benchmark::State& state) {
+  const auto normals = sphere_normals(state.range(0));
+  std::vector<mr::OctNorm<Bits>> encoded(normals.size());
+  for (auto _ : state) {
+    mr::oct_encode(normals, encoded);
+    benchmark::DoNotOptimize(encoded.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_oct_encode<16>)->Arg(1 << 16);
+BENCHMARK(BM_oct_encode<24>)->Arg(1 << 16);
+BENCHMARK(BM_oct_encode<32>)->Arg(1 << 16);
+
+template <size_t Bits>
+static void BM_oct_decode(benchmark::State& state) {
+  const auto normals = sphere_normals(state.range(0));
+  std::vector<mr::OctNorm<Bits>> encoded(normals.size());
+  std::vector<mr::Norm3f> decoded(normals.size(), mr::Norm3f(1, 0, 0));
+  mr::oct_encode(normals, encoded);
+  for (auto _ : state) {
+    mr::oct_decode(encoded, decoded);
+    benchmark::DoNotOptimize(decoded.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  max_oct_error(state, normals, decoded);
+}
+BENCHMARK(BM_oct_decode<16>)->Arg(1 << 16);
+BENCHMARK(BM_oct_decode<24>)->Arg(1 << 16);
+BENCHMARK(BM_oct_decode<32>)->Arg(1 << 16);
+
+static void BM_bounds(benchmark::State& state) {
+  std::vector<mr::Vec3f> points(state.range(0));
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = mr::Vec3f(i % 7, i % 13, i % 17);
+  }
+  for (auto _ : state) {
+    auto box = mr::bounds(points);
+    benchmark::DoNotOptimize(box);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_bounds)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_bounds_parallel(benchmark::State& state) {
+  std::vector<mr::Vec3f> points(state.range(0));
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = mr::Vec3f(i % 7, i % 13, i % 17);
+  }
+  for (auto _ : state) {
+    auto box = mr::bounds(points, mr::parallel);
+    benchmark::DoNotOptimize(box);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_bounds_parallel)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+
+static void BM_bounds_loop(benchmark::State& state) {
+  std::vector<mr::Vec3f> points(state.range(0));
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = mr::Vec3f(i % 7, i % 13, i % 17);
+  }
+  for (auto _ : state) {
+    mr::AABBf box {points[0], points[0]};
+    for (const auto &p : points) {
+      box.min = mr::Vec3f(std::min(box.min.x(), p.x()), std::min(box.min.y(), p.y()), std::min(box.min.z(), p.z()));
+      box.max = mr::Vec3f(std::max(box.max.x(), p.x()), std::max(box.max.y(), p.y()), std::max(box.max.z(), p.z()));
+    }
+    benchmark::DoNotOptimize(box);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_bounds_loop)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_eager_expression(benchmark::State& state) {
+  for (auto _ : state) {
+    mr::Vec3f v = v1 * v2 + v3 * v1 - v2;
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_eager_expression);
+
+static void BM_lazy_expression(benchmark::State& state) {
+  for (auto _ : state) {
+    mr::Vec3f v = mr::lazy(v1) * v2 + v3 * v1 - v2;
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_lazy_expression);
+
+static void BM_lerp_batch(benchmark::State& state) {
+  std::vector<float> from(state.range(0), 1.f), to(state.range(0), 2.f), out(state.range(0));
+  for (auto _ : state) {
+    mr::lerp(from, to, 0.3f, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_lerp_batch)->Arg(1 << 16);
+
 static void BM_dot(benchmark::State& state) {
   for (auto _ : state) {
     auto v4 = v1.dot(v3);
@@ -128,16 +423,346 @@ static void BM_matrix_multiplication(benchmark::State& state) {
 
 BENCHMARK(BM_matrix_multiplication);
 
-#if 0
-static void BM_matrix_inversed(benchmark::State& state) {
+static void BM_matrix3_multiplication(benchmark::State& state) {
+  const mr::Matr3f a3 {a, 2, 3, 4, 5, 6, 7, 8, 9};
   for (auto _ : state) {
-    auto m3 = m1.inversed();
+    auto m3 = a3 * a3;
     benchmark::DoNotOptimize(m3);
   }
 }
+BENCHMARK(BM_matrix3_multiplication);
+
+static void BM_multiply_batch(benchmark::State& state) {
+  std::vector<mr::Matr4f> models(state.range(0), m_affine), out(models.size());
+  for (auto _ : state) {
+    mr::multiply(models, m_rigid, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_multiply_batch)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_multiply_batch_parallel(benchmark::State& state) {
+  std::vector<mr::Matr4f> models(state.range(0), m_affine), out(models.size());
+  for (auto _ : state) {
+    mr::multiply(models, m_rigid, out, mr::parallel);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_multiply_batch_parallel)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+
+static void BM_multiply_batch_pairs(benchmark::State& state) {
+  std::vector<mr::Matr4f> parents(state.range(0), m_rigid), locals(parents.size(), m_affine), out(parents.size());
+  for (auto _ : state) {
+    mr::multiply(locals, parents, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_multiply_batch_pairs)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
 
+static void BM_multiply_batch_loop(benchmark::State& state) {
+  std::vector<mr::Matr4f> models(state.range(0), m_affine), out(models.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < models.size(); i++) {
+      out[i] = models[i] * m_rigid;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_multiply_batch_loop)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+template <mr::Isa I, typename T>
+static void BM_multiply_batch_isa(benchmark::State& state) {
+  if (!mr::force_isa(I)) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+  std::vector<mr::Matr4<T>> parents(state.range(0), rigid_matr<T>()), locals(parents.size(), affine_matr<T>());
+  std::vector<mr::Matr4<T>> out(parents.size());
+  for (auto _ : state) {
+    mr::multiply(locals, parents, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  mr::reset_isa();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_multiply_batch_isa<mr::Isa::generic, float>)->Arg(1 << 16);
+BENCHMARK(BM_multiply_batch_isa<mr::Isa::avx2, float>)->Arg(1 << 16);
+BENCHMARK(BM_multiply_batch_isa<mr::Isa::avx512, float>)->Arg(1 << 16);
+BENCHMARK(BM_multiply_batch_isa<mr::Isa::generic, double>)->Arg(1 << 16);
+BENCHMARK(BM_multiply_batch_isa<mr::Isa::avx2, double>)->Arg(1 << 16);
+BENCHMARK(BM_multiply_batch_isa<mr::Isa::avx512, double>)->Arg(1 << 16);
+
+template <mr::Isa I, typename T>
+static void BM_transpose_batch_isa(benchmark::State& state) {
+  if (!mr::force_isa(I)) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+  std::vector<mr::Matr4<T>> models(state.range(0), affine_matr<T>()), out(models.size());
+  for (auto _ : state) {
+    mr::transpose(models, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  mr::reset_isa();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_transpose_batch_isa<mr::Isa::generic, float>)->Arg(1 << 16);
+BENCHMARK(BM_transpose_batch_isa<mr::Isa::avx512, float>)->Arg(1 << 16);
+BENCHMARK(BM_transpose_batch_isa<mr::Isa::generic, double>)->Arg(1 << 16);
+BENCHMARK(BM_transpose_batch_isa<mr::Isa::avx2, double>)->Arg(1 << 16);
+BENCHMARK(BM_transpose_batch_isa<mr::Isa::avx512, double>)->Arg(1 << 16);
+
+static void BM_matrix4d_multiplication(benchmark::State& state) {
+  const mr::Matr4d a1 = affine_matr<double>(), a2 = rigid_matr<double>();
+  for (auto _ : state) {
+    auto a3 = a1 * a2;
+    benchmark::DoNotOptimize(a3);
+  }
+}
+BENCHMARK(BM_matrix4d_multiplication);
+
+// 4-ary tree, every node but the root has a parent with a smaller index
+static mr::Hierarchyf make_hierarchy(size_t size) {
+  mr::Hierarchyf scene;
+  scene.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    scene.add(i == 0 ? m_rigid : m_affine, i == 0 ? mr::Hierarchyf::no_parent : i / 4);
+  }
+  return scene;
+}
+
+static void BM_hierarchy_update(benchmark::State& state) {
+  mr::Hierarchyf scene = make_hierarchy(state.range(0));
+  for (auto _ : state) {
+    scene.set_local(0, m_rigid);
+    benchmark::DoNotOptimize(scene.update());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hierarchy_update)->Arg(1 << 16);
+
+static void BM_hierarchy_update_parallel(benchmark::State& state) {
+  mr::Hierarchyf scene = make_hierarchy(state.range(0));
+  for (auto _ : state) {
+    scene.set_local(0, m_rigid);
+    benchmark::DoNotOptimize(scene.update(mr::parallel));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hierarchy_update_parallel)->Arg(1 << 16)->UseRealTime();
+
+// only a few small subtrees change
+static void BM_hierarchy_update_sparse(benchmark::State& state) {
+  mr::Hierarchyf scene = make_hierarchy(state.range(0));
+  for (auto _ : state) {
+    for (size_t i = state.range(0) / 2; i < size_t(state.range(0)); i += 1024) {
+      scene.set_local(i, m_affine);
+    }
+    benchmark::DoNotOptimize(scene.update());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hierarchy_update_sparse)->Arg(1 << 16);
+
+// hand written loop over Matr4f with parent indices
+static void BM_hierarchy_loop(benchmark::State& state) {
+  std::vector<mr::Matr4f> locals(state.range(0), m_affine), worlds(locals.size());
+  locals[0] = m_rigid;
+  for (auto _ : state) {
+    worlds[0] = locals[0];
+    for (size_t i = 1; i < locals.size(); i++) {
+      worlds[i] = locals[i] * worlds[i / 4];
+    }
+    benchmark::DoNotOptimize(worlds.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hierarchy_loop)->Arg(1 << 16);
+
+static void BM_matrix_normal_matrix(benchmark::State& state) {
+  for (auto _ : state) {
+    auto n = m_affine.normal_matrix();
+    benchmark::DoNotOptimize(n);
+  }
+}
+BENCHMARK(BM_matrix_normal_matrix);
+
+static void BM_matrix_normal_matrix_uniform(benchmark::State& state) {
+  const mr::Matr4f m = mr::Matr4f::scale({2, 2, 2}) * m_rigid;
+  for (auto _ : state) {
+    auto n = m.normal_matrix();
+    benchmark::DoNotOptimize(n);
+  }
+}
+BENCHMARK(BM_matrix_normal_matrix_uniform);
+
+static void BM_normal_matrix_batch(benchmark::State& state) {
+  std::vector<mr::Matr4f> models(state.range(0), m_affine);
+  std::vector<mr::Matr<float, 3, 4>> out(models.size());
+  for (auto _ : state) {
+    mr::normal_matrix(models, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_normal_matrix_batch)->Arg(1 << 10);
+
+static void BM_matrix_rotate_axis_angle(benchmark::State& state) {
+  const mr::Norm3f axis = mr::Vec3f(a, 1, 1).normalized().value();
+  for (auto _ : state) {
+    auto m = mr::Matr4f::rotate(axis, mr::Radiansf(a));
+    benchmark::DoNotOptimize(m);
+  }
+}
+BENCHMARK(BM_matrix_rotate_axis_angle);
+
+static void BM_rotate_batch(benchmark::State& state) {
+  std::vector<mr::Norm3f> axes(state.range(0), mr::Vec3f(a, 1, 1).normalized().value());
+  std::vector<mr::Radiansf> angles(axes.size());
+  for (size_t i = 0; i < angles.size(); i++) {
+    angles[i] = mr::Radiansf(0.001f * i);
+  }
+  std::vector<mr::Matr4f> out(axes.size());
+  for (auto _ : state) {
+    mr::rotate(axes, angles, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rotate_batch)->Arg(1 << 10);
+
+static void BM_matrix_trs(benchmark::State& state) {
+  const mr::Quat<float> q = *mr::Quat<float>(mr::Radiansf(a), 0.1, -0.3, 0.2).normalized();
+  for (auto _ : state) {
+    auto m = mr::Matr4f::trs({30, 47, 80}, q, {2, a, 3});
+    benchmark::DoNotOptimize(m);
+  }
+}
+BENCHMARK(BM_matrix_trs);
+
+// scale * rotation * translate with full products
+static void BM_matrix_trs_products(benchmark::State& state) {
+  const mr::Matr4f rot = mr::Matr4f::rotate({a, 1, 1}, mr::Radians<float>(a));
+  for (auto _ : state) {
+    auto m = mr::Matr4f::scale({2, a, 3}) * rot * mr::Matr4f::translate({30, 47, 80});
+    benchmark::DoNotOptimize(m);
+  }
+}
+BENCHMARK(BM_matrix_trs_products);
+
+static void BM_matrix_decompose(benchmark::State& state) {
+  for (auto _ : state) {
+    auto trs = m_affine.decompose();
+    benchmark::DoNotOptimize(trs);
+  }
+}
+BENCHMARK(BM_matrix_decompose);
+
+static void BM_quat_multiplication(benchmark::State& state) {
+  const mr::Quatf q1 = *mr::Quatf(mr::Radiansf(a), 0.1, -0.3, 0.2).normalized();
+  const mr::Quatf q2 = *mr::Quatf(mr::Radiansf(0.2), -0.1, 0.9, a).normalized();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q1 * q2);
+  }
+}
+BENCHMARK(BM_quat_multiplication);
+
+static void BM_quat_rotate(benchmark::State& state) {
+  const mr::Quatf q = *mr::Quatf(mr::Radiansf(a), 0.1, -0.3, 0.2).normalized();
+  const mr::Vec3f v {a, 2, 3};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q.rotate(v));
+  }
+}
+BENCHMARK(BM_quat_rotate);
+
+static void BM_compose_batch(benchmark::State& state) {
+  std::vector<mr::Trsf> bones(state.range(0), m_affine.decompose());
+  std::vector<mr::Matr4f> out(bones.size());
+  for (auto _ : state) {
+    mr::compose(bones, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_compose_batch)->Arg(1 << 10);
+
+static void BM_decompose_batch(benchmark::State& state) {
+  std::vector<mr::Matr4f> matrices(state.range(0), m_affine);
+  std::vector<mr::Trsf> out(matrices.size());
+  for (auto _ : state) {
+    mr::decompose(matrices, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_decompose_batch)->Arg(1 << 10);
+
+static void BM_affine_multiplication(benchmark::State& state) {
+  const mr::Affine3f a1 {m_affine}, a2 {m_rigid};
+  for (auto _ : state) {
+    auto a3 = a1 * a2;
+    benchmark::DoNotOptimize(a3);
+  }
+}
+BENCHMARK(BM_affine_multiplication);
+
+static void BM_affine_inversed(benchmark::State& state) {
+  const mr::Affine3f a1 {m_affine};
+  for (auto _ : state) {
+    auto a3 = a1.inversed();
+    benchmark::DoNotOptimize(a3);
+  }
+}
+BENCHMARK(BM_affine_inversed);
+
+static void BM_affine_transform_point(benchmark::State& state) {
+  const mr::Affine3f a1 {m_affine};
+  for (auto _ : state) {
+    auto v = a1.transform_point(v1);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_affine_transform_point);
+
+static void BM_matrix_inversed(benchmark::State& state) {
+  for (auto _ : state) {
+    auto m3 = m_affine.inversed();
+    benchmark::DoNotOptimize(m3);
+  }
+}
 BENCHMARK(BM_matrix_inversed);
-#endif
+
+static void BM_matrix_inversed_affine(benchmark::State& state) {
+  for (auto _ : state) {
+    auto m3 = m_affine.inversed_affine();
+    benchmark::DoNotOptimize(m3);
+  }
+}
+BENCHMARK(BM_matrix_inversed_affine);
+
+static void BM_matrix_inversed_rigid(benchmark::State& state) {
+  for (auto _ : state) {
+    auto m3 = m_rigid.inversed_rigid();
+    benchmark::DoNotOptimize(m3);
+  }
+}
+BENCHMARK(BM_matrix_inversed_rigid);
 
 static void BM_matrix_determinant(benchmark::State& state) {
   for (auto _ : state) {
@@ -148,6 +773,26 @@ static void BM_matrix_determinant(benchmark::State& state) {
 
 BENCHMARK(BM_matrix_determinant);
 
+static void BM_matrix_determinant3(benchmark::State& state) {
+  for (auto _ : state) {
+    auto m3 = m1.determinant3();
+    benchmark::DoNotOptimize(m3);
+  }
+}
+BENCHMARK(BM_matrix_determinant3);
+
+static void BM_matrix_determinant_batch(benchmark::State& state) {
+  std::vector<mr::Matr4f> matrices(state.range(0), m_affine);
+  std::vector<float> dets(matrices.size());
+  for (auto _ : state) {
+    mr::determinant(matrices, dets);
+    benchmark::DoNotOptimize(dets.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_matrix_determinant_batch)->Arg(1 << 12);
+
 static void BM_matrix_transposed(benchmark::State& state) {
   for (auto _ : state) {
     auto v3 = m1.transposed();
@@ -156,6 +801,53 @@ static void BM_matrix_transposed(benchmark::State& state) {
 }
 BENCHMARK(BM_matrix_transposed);
 
+// element gather, the baseline for the shuffle transposition above
+static void BM_matrix_transposed_gather(benchmark::State& state) {
+  for (auto _ : state) {
+    mr::Matr4f v3;
+    mr::details::unroll<4>([&](auto j) {
+      v3[j] = mr::SimdImpl<float, 4>([j](size_t i) { return m1[i][j]; });
+    });
+    benchmark::DoNotOptimize(v3);
+  }
+}
+BENCHMARK(BM_matrix_transposed_gather);
+
+static void BM_aos_to_soa(benchmark::State& state) {
+  std::vector<mr::Vec4f> aos(state.range(0), mr::Vec4f(a, 2, 3, 4));
+  std::vector<float> x(aos.size()), y(aos.size()), z(aos.size()), w(aos.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < aos.size(); i += 8) {
+      const auto [sx, sy, sz, sw] = mr::aos_to_soa<8>(aos.data() + i);
+      sx.store(x.data() + i, mr::unaligned);
+      sy.store(y.data() + i, mr::unaligned);
+      sz.store(z.data() + i, mr::unaligned);
+      sw.store(w.data() + i, mr::unaligned);
+    }
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_aos_to_soa)->Arg(1 << 12);
+
+static void BM_aos_to_soa_loop(benchmark::State& state) {
+  std::vector<mr::Vec4f> aos(state.range(0), mr::Vec4f(a, 2, 3, 4));
+  std::vector<float> x(aos.size()), y(aos.size()), z(aos.size()), w(aos.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < aos.size(); i++) {
+      x[i] = aos[i].x();
+      y[i] = aos[i].y();
+      z[i] = aos[i].z();
+      w[i] = aos[i].w();
+    }
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_aos_to_soa_loop)->Arg(1 << 12);
+
 
 [[maybe_unused]]
 static void compile_test() {
@@ -0,0 +1,213 @@
+#ifndef __MR_AFFINE_HPP_
+#define __MR_AFFINE_HPP_
+
+#include "def.hpp"
+#include "row.hpp"
+#include "vec.hpp"
+#include "matr.hpp"
+
+// affine transformation stored as 3x4 matrix (the constant (0, 0, 0, 1) column of Matr4 is dropped)
+// same semantics as Matr4: 'a * b' applies 'a' first, 'v * a' transforms point 'v'
+//   mr::Affine3f world = mr::Affine3f(mr::Matr4f::scale({1, 2, 3})) * mr::Affine3f::translate({30, 47, 80});
+//   mr::Vec3f p = world.transform_point(v);
+//   mr::Matr4f m = world;   // back to 4x4
+// rows are (linear part row | translation) for column vectors, so they can be uploaded to
+// gpu as row-major float3x4 directly (see store)
+
+namespace mr {
+  // forward declarations
+  template <std::floating_point T>
+    struct Affine3;
+
+  // common aliases
+  using Affine3f = Affine3<float>;
+  using Affine3d = Affine3<double>;
+
+  template <std::floating_point T>
+    struct [[nodiscard]] Affine3 {
+    public:
+      using ValueT = T;
+      using RowT = Row<T, 4>;
+      using SimdT = SimdImpl<T, 4>;
+
+      std::array<RowT, 3> _data;
+
+      constexpr Affine3() noexcept = default;
+
+      constexpr Affine3(const RowT &r0, const RowT &r1, const RowT &r2) noexcept : _data {r0, r1, r2} {}
+
+      // from 4x4 matrix (last column is assumed to be (0, 0, 0, 1))
+      constexpr explicit Affine3(const Matr4<T> &m) noexcept {
+        const auto [r0, r1, r2] = mr::details::transpose3_simd(m[0]._data, m[1]._data, m[2]._data);
+        _data = {
+          RowT(r0 + _w(m[3][0])),
+          RowT(r1 + _w(m[3][1])),
+          RowT(r2 + _w(m[3][2]))
+        };
+      }
+
+      // from memory constructor (reads 12 elements in row-major order)
+      template <typename Flags>
+        constexpr Affine3(const T *data, Flags flags) noexcept {
+          for (size_t i = 0; i < 3; i++) {
+            _data[i] = RowT(data + 4 * i, flags);
+          }
+        }
+
+      constexpr operator Matr4<T>() const noexcept {
+        const auto [r0, r1, r2] = mr::details::transpose3_simd(_data[0]._data, _data[1]._data, _data[2]._data);
+        return Matr4<T> {RowT(r0), RowT(r1), RowT(r2), RowT(_translation_simd() + _w(1))};
+      }
+
+      // load/store methods in row-major order (see mr::aligned, mr::unaligned, mr::streaming)
+      [[nodiscard]] static constexpr Affine3 load(const T *data) noexcept {
+        return Affine3(data, unaligned);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Affine3 load(const T *data, Flags flags) noexcept {
+          return Affine3(data, flags);
+        }
+
+      constexpr void store(T *data) const noexcept {
+        store(data, unaligned);
+      }
+
+      template <typename Flags>
+        constexpr void store(T *data, Flags flags) const noexcept {
+          for (size_t i = 0; i < 3; i++) {
+            _data[i].store(data + 4 * i, flags);
+          }
+        }
+
+      // composition ('*this' is applied first), 36 multiply-adds
+      constexpr Affine3 operator*(const Affine3 &other) const noexcept {
+        const SimdT e3 = _w(1);
+        Affine3 res;
+        for (size_t i = 0; i < 3; i++) {
+          const SimdT &o = other._data[i]._data;
+          res._data[i] = o[0] * _data[0]._data + o[1] * _data[1]._data + o[2] * _data[2]._data + o[3] * e3;
+        }
+        return res;
+      }
+
+      constexpr Affine3 & operator*=(const Affine3 &other) noexcept {
+        *this = *this * other;
+        return *this;
+      }
+
+      [[nodiscard]] constexpr Vec3<T> transform_point(const Vec3<T> &v) const noexcept {
+        const SimdT p = mr::details::row_simd(Vec4<T>(v.x(), v.y(), v.z(), 1));
+        return {(_data[0]._data * p).sum(), (_data[1]._data * p).sum(), (_data[2]._data * p).sum()};
+      }
+
+      // translation is ignored
+      [[nodiscard]] constexpr Vec3<T> transform_direction(const Vec3<T> &v) const noexcept {
+        const SimdT d = mr::details::row_simd(Vec4<T>(v.x(), v.y(), v.z(), 0));
+        return {(_data[0]._data * d).sum(), (_data[1]._data * d).sum(), (_data[2]._data * d).sum()};
+      }
+
+      friend constexpr Vec3<T> operator*(const Vec3<T> &v, const Affine3 &a) noexcept {
+        return a.transform_point(v);
+      }
+
+      // general inverse (linear part is inverted with cross products, must be invertible)
+      constexpr Affine3 inversed() const noexcept {
+        const SimdT &r0 = _data[0]._data, &r1 = _data[1]._data, &r2 = _data[2]._data;
+        const SimdT c0 = mr::details::cross_simd(r1, r2);
+        const SimdT c1 = mr::details::cross_simd(r2, r0);
+        const SimdT c2 = mr::details::cross_simd(r0, r1);
+        const T inv_det = T(1) / (r0 * c0).sum();
+        const auto [i0, i1, i2] = mr::details::transpose3_simd(c0, c1, c2);
+        return _from_linear_inverse(i0 * inv_det, i1 * inv_det, i2 * inv_det);
+      }
+
+      // inverse of a rotation + translation (linear part must be orthonormal)
+      constexpr Affine3 inversed_rigid() const noexcept {
+        const auto [i0, i1, i2] = mr::details::transpose3_simd(_data[0]._data, _data[1]._data, _data[2]._data);
+        return _from_linear_inverse(i0, i1, i2);
+      }
+
+      constexpr Affine3 & inverse() noexcept {
+        *this = inversed();
+        return *this;
+      }
+
+      constexpr Affine3 & inverse_rigid() noexcept {
+        *this = inversed_rigid();
+        return *this;
+      }
+
+      [[nodiscard]] constexpr Vec3<T> translation() const noexcept {
+        return {_data[0][3], _data[1][3], _data[2][3]};
+      }
+
+      // determinant of the linear part (negative for transformations which mirror)
+      [[nodiscard]] constexpr T determinant() const noexcept {
+        return (_data[0]._data * mr::details::cross_simd(_data[1]._data, _data[2]._data)).sum();
+      }
+
+      static constexpr Affine3 identity() noexcept {
+        return {RowT(1, 0, 0, 0), RowT(0, 1, 0, 0), RowT(0, 0, 1, 0)};
+      }
+
+      static constexpr Affine3 translate(const Vec3<T> &vec) noexcept {
+        return {RowT(1, 0, 0, vec.x()), RowT(0, 1, 0, vec.y()), RowT(0, 0, 1, vec.z())};
+      }
+
+      static constexpr Affine3 scale(const Vec3<T> &vec) noexcept {
+        return {RowT(vec.x(), 0, 0, 0), RowT(0, vec.y(), 0, 0), RowT(0, 0, vec.z(), 0)};
+      }
+
+      [[nodiscard]] constexpr const RowT & operator[](size_t i) const noexcept {
+        return _data[i];
+      }
+
+      [[nodiscard]] constexpr RowT & operator[](size_t i) noexcept {
+        return _data[i];
+      }
+
+      constexpr bool operator==(const Affine3 &other) const noexcept {
+        return _data[0] == other._data[0] && _data[1] == other._data[1] && _data[2] == other._data[2];
+      }
+
+      constexpr bool equal(const Affine3 &other, ValueT eps = epsilon<ValueT>()) const noexcept {
+        for (size_t i = 0; i < 3; i++) {
+          if (not _data[i].equal(other._data[i], eps)) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      friend std::ostream & operator<<(std::ostream &os, const Affine3 &a) noexcept {
+        os << "\n(" << a[0] << ",\n " << a[1] << ",\n " << a[2] << ')';
+        return os;
+      }
+
+    private:
+      // (0, 0, 0, w)
+      static constexpr SimdT _w(T w) noexcept {
+        return SimdT([w](size_t i) { return i == 3 ? w : T(0); });
+      }
+
+      // (tx, ty, tz, 0)
+      constexpr SimdT _translation_simd() const noexcept {
+        return SimdT([this](size_t i) { return i < 3 ? _data[i][3] : T(0); });
+      }
+
+      // rows of the inverse linear part (their w must be 0) with translation -inverse * t
+      constexpr Affine3 _from_linear_inverse(const SimdT &i0, const SimdT &i1, const SimdT &i2) const noexcept {
+        const SimdT t = _translation_simd();
+        return {
+          RowT(i0 - _w((i0 * t).sum())),
+          RowT(i1 - _w((i1 * t).sum())),
+          RowT(i2 - _w((i2 * t).sum()))
+        };
+      }
+    };
+
+  static_assert(sizeof(Affine3f) == 12 * sizeof(float));
+} // namespace mr
+
+#endif // __MR_AFFINE_HPP_
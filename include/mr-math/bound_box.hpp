@@ -23,21 +23,21 @@ namespace mr {
       constexpr bool contains(const VecT &point) const noexcept {
         return
           min.x() <= point.x() && point.x() <= max.x() &&
-          min.y() <= point.y() && point.y() <= max.x() &&
+          min.y() <= point.y() && point.y() <= max.y() &&
           min.z() <= point.z() && point.z() <= max.z();
       }
 
       constexpr bool contains(const AABB &other) const noexcept {
         return
           min.x() <= other.min.x() && other.max.x() <= max.x() &&
-          min.y() <= other.min.y() && other.max.y() <= max.x() &&
+          min.y() <= other.min.y() && other.max.y() <= max.y() &&
           min.z() <= other.min.z() && other.max.z() <= max.z();
       }
 
       constexpr bool intersects(const AABB &other) const noexcept {
         return
           min.x() <= other.max.x() && other.min.x() <= max.x() &&
-          min.y() <= other.max.y() && other.min.y() <= max.x() &&
+          min.y() <= other.max.y() && other.min.y() <= max.y() &&
           min.z() <= other.max.z() && other.min.z() <= max.z();
       }
 
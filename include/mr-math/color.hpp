@@ -3,8 +3,20 @@
 
 #include "def.hpp"
 #include "vec.hpp"
+#include "functions.hpp"
+#include "dispatch.hpp"
 
 namespace mr {
+  namespace details {
+    // out[i] = channels I... of colors[i] (e.g. 3, 0, 1, 2 for argb)
+    template <typename C, std::size_t ...I>
+      MR_MATH_KERNEL void color_swizzle_kernel(const C *colors, Vec4f *out, std::size_t size, std::index_sequence<I...>) noexcept {
+        for (size_t i = 0; i < size; i++) {
+          out[i] = colors[i].template swizzle<I...>();
+        }
+      }
+    MR_MATH_DISPATCHED(color_swizzle)
+  } // namespace details
 
   // color in RGBA float format
   struct [[nodiscard]] Color {
@@ -67,17 +79,34 @@ namespace mr {
     }
 
     // format conversions
-    // TODO: implement using shuffle
+    template <size_t ...I> requires (sizeof...(I) == 4)
+      Vec4f swizzle() const noexcept {
+        return _data.swizzle<I...>();
+      }
+
     Vec4f argb() const noexcept {
-      return {a(), r(), g(), b()};
+      return swizzle<3, 0, 1, 2>();
     }
 
     Vec4f bgra() const noexcept {
-      return {b(), g(), r(), a()};
+      return swizzle<2, 1, 0, 3>();
     }
 
     Vec4f abgr() const noexcept {
-      return {a(), b(), g(), r()};
+      return swizzle<3, 2, 1, 0>();
+    }
+
+    // batch format conversions (runtime dispatched, see dispatch.hpp)
+    static void argb(std::span<const Color> colors, std::span<Vec4f> out) noexcept {
+      _convert<3, 0, 1, 2>(colors, out);
+    }
+
+    static void bgra(std::span<const Color> colors, std::span<Vec4f> out) noexcept {
+      _convert<2, 1, 0, 3>(colors, out);
+    }
+
+    static void abgr(std::span<const Color> colors, std::span<Vec4f> out) noexcept {
+      _convert<3, 2, 1, 0>(colors, out);
     }
 
     friend Color operator+(Color lhs, const Color &rhs) noexcept {
@@ -105,10 +134,71 @@ namespace mr {
       return s;
     }
 
+    // blending (defined below)
+    friend Color lerp(const Color &a, const Color &b, ValueT t) noexcept;
+    friend Color lerp(const Color &a, const Color &b, const Color &t) noexcept;
+    friend Color min(const Color &a, const Color &b) noexcept;
+    friend Color max(const Color &a, const Color &b) noexcept;
+    friend Color saturate(const Color &c) noexcept;
+
   private:
+    template <size_t ...I>
+      static void _convert(std::span<const Color> colors, std::span<Vec4f> out) noexcept {
+        assert(colors.size() >= out.size());
+        mr::details::color_swizzle(colors.data(), out.data(), out.size(), std::index_sequence<I...>{});
+      }
+
     Vec4f _data;
   };
 
+  // blending
+  inline Color lerp(const Color &a, const Color &b, Color::ValueT t) noexcept {
+    return mr::lerp(a._data, b._data, t);
+  }
+
+  inline Color lerp(const Color &a, const Color &b, const Color &t) noexcept {
+    return mr::lerp(a._data, b._data, t._data);
+  }
+
+  inline Color mix(const Color &a, const Color &b, Color::ValueT t) noexcept {
+    return lerp(a, b, t);
+  }
+
+  inline Color mix(const Color &a, const Color &b, const Color &t) noexcept {
+    return lerp(a, b, t);
+  }
+
+  inline Color min(const Color &a, const Color &b) noexcept {
+    return mr::min(a._data, b._data);
+  }
+
+  inline Color max(const Color &a, const Color &b) noexcept {
+    return mr::max(a._data, b._data);
+  }
+
+  inline Color saturate(const Color &c) noexcept {
+    return mr::saturate(c._data);
+  }
+
+  // batch versions
+  inline void lerp(std::span<const Color> a, std::span<const Color> b, Color::ValueT t, std::span<Color> out) noexcept {
+    assert(a.size() >= out.size() && b.size() >= out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+      out[i] = lerp(a[i], b[i], t);
+    }
+  }
+
+  inline void mix(std::span<const Color> a, std::span<const Color> b, Color::ValueT t, std::span<Color> out) noexcept {
+    lerp(a, b, t, out);
+  }
+
+  inline void saturate(std::span<const Color> colors, std::span<Color> out) noexcept {
+    assert(colors.size() >= out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+      out[i] = saturate(colors[i]);
+    }
+  }
+
 namespace literals {
 
   inline Color operator"" _rgba(unsigned long long value) {
@@ -14,7 +14,12 @@
 #include <mutex>
 #include <cmath>
 #include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include <bit>
+#include <cstring>
 #ifdef __cpp_lib_format
   #include <format>
 #endif
@@ -23,6 +28,14 @@
 
 namespace stdx = Vc;
 
+// small helpers called from runtime dispatched kernels (see dispatch.hpp) are always inlined,
+// so every dispatched copy gets them compiled for its own target
+#if defined(__GNUC__) || defined(__clang__)
+  #define MR_MATH_INLINE [[gnu::always_inline]] inline
+#else
+  #define MR_MATH_INLINE inline
+#endif
+
 namespace mr {
   template <typename T>
     concept ArithmeticT = std::integral<T> || std::floating_point<T>;
@@ -30,6 +43,10 @@ namespace mr {
   template <ArithmeticT T, std::size_t N>
     using SimdImpl = stdx::fixed_size_simd<T, N>;
 
+  // widest native register for T (used by batch kernels)
+  template <ArithmeticT T>
+    using NativeSimdImpl = stdx::Vector<T>;
+
   template<ArithmeticT T>
     constexpr T epsilon() {
       return std::numeric_limits<T>::epsilon();
@@ -69,6 +86,13 @@ namespace mr {
 
   inline struct UncheckedTag {} unchecked;
 
+  // memory access flags for load/store methods
+  // 'aligned' requires address aligned to alignof(SimdImpl<T, N>)
+  // 'streaming' is an aligned non-temporal access which bypasses the cache
+  inline constexpr auto aligned = stdx::Aligned;
+  inline constexpr auto unaligned = stdx::Unaligned;
+  inline constexpr auto streaming = stdx::Aligned | stdx::Streaming;
+
   // inclusive numeric interval [low, high]
   // use operator() to check if value is in range
   template<typename L, typename H>
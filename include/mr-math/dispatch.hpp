@@ -0,0 +1,130 @@
+#ifndef __MR_DISPATCH_HPP_
+#define __MR_DISPATCH_HPP_
+
+#include "def.hpp"
+
+// runtime instruction set selection for batch kernels
+// every dispatched kernel is compiled for sse4.2, avx2 and avx512 in addition to the
+// build target, and the widest version supported by the cpu is picked on first use:
+//   std::cout << mr::active_isa();      // e.g. "avx2"
+//   mr::force_isa(mr::Isa::sse42);      // e.g. to test a specific path
+//   mr::reset_isa();
+// kernels are plain loops over scalars (structure-of-arrays blocks) which every copy vectorizes
+// for its own register width (-O3 for gcc, -O2 for clang); Vc types used inside a kernel keep the
+// width of the build target and only get the newer encodings (e.g. the 4 wide Color swizzles);
+// dispatch requires gcc or clang on x86, otherwise only the generic version is used
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define MR_MATH_RUNTIME_DISPATCH 1
+  #include <immintrin.h>
+#else
+  #define MR_MATH_RUNTIME_DISPATCH 0
+#endif
+
+namespace mr {
+  // ordered from narrowest to widest
+  enum class Isa {
+    generic, // build target (e.g. sse2 for default x86_64 builds)
+    sse42,
+    avx2,    // avx2 + fma + f16c
+    avx512,  // avx512f + avx512vl (+ avx2 tier)
+  };
+
+  constexpr std::string_view isa_name(Isa isa) noexcept {
+    switch (isa) {
+      case Isa::sse42:  return "sse4.2";
+      case Isa::avx2:   return "avx2";
+      case Isa::avx512: return "avx512";
+      default:          return "generic";
+    }
+  }
+
+  inline std::ostream & operator<<(std::ostream &os, Isa isa) noexcept {
+    os << isa_name(isa);
+    return os;
+  }
+
+  // widest instruction set supported by the cpu (cpuid is queried once)
+  inline Isa detected_isa() noexcept {
+#if MR_MATH_RUNTIME_DISPATCH
+    static const Isa isa = [] {
+      __builtin_cpu_init();
+      const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+      if (avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) {
+        return Isa::avx512;
+      }
+      if (avx2) {
+        return Isa::avx2;
+      }
+      if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::sse42;
+      }
+      return Isa::generic;
+    }();
+    return isa;
+#else
+    return Isa::generic;
+#endif
+  }
+
+  namespace details {
+    inline std::atomic<Isa> & isa_storage() noexcept {
+      static std::atomic<Isa> isa {detected_isa()};
+      return isa;
+    }
+  } // namespace details
+
+  // instruction set used by dispatched kernels
+  inline Isa active_isa() noexcept {
+    return mr::details::isa_storage().load(std::memory_order_relaxed);
+  }
+
+  // forces dispatched kernels to use 'isa'
+  // returns false (and keeps the current selection) if the cpu does not support it
+  inline bool force_isa(Isa isa) noexcept {
+    if (isa > detected_isa()) {
+      return false;
+    }
+    mr::details::isa_storage().store(isa, std::memory_order_relaxed);
+    return true;
+  }
+
+  // restores automatic selection
+  inline void reset_isa() noexcept {
+    mr::details::isa_storage().store(detected_isa(), std::memory_order_relaxed);
+  }
+} // namespace mr
+
+// kernel body; always inlined so it is compiled for the target of every dispatched copy
+// kernels should avoid std::sqrt/std::fma and floating point selects,
+// which prevent vectorization without -ffast-math
+// MR_MATH_DISPATCHED(name) defines 'name(args...)' which runs 'name##_kernel(args...)'
+// compiled for mr::active_isa()
+#if MR_MATH_RUNTIME_DISPATCH
+  #define MR_MATH_KERNEL [[gnu::always_inline]] inline
+
+  #define MR_MATH_DISPATCHED(name)                                                          \
+    template <typename ...Args> [[gnu::target("sse4.2")]]                                   \
+      void name##_sse42(Args ...args) noexcept { name##_kernel(args...); }                  \
+    template <typename ...Args> [[gnu::target("avx2,fma,f16c")]]                            \
+      void name##_avx2(Args ...args) noexcept { name##_kernel(args...); }                   \
+    template <typename ...Args> [[gnu::target("avx512f,avx512vl,avx2,fma,f16c")]]           \
+      void name##_avx512(Args ...args) noexcept { name##_kernel(args...); }                 \
+    template <typename ...Args>                                                             \
+      void name(Args ...args) noexcept {                                                    \
+        switch (mr::active_isa()) {                                                         \
+          case mr::Isa::avx512: return name##_avx512(args...);                              \
+          case mr::Isa::avx2:   return name##_avx2(args...);                                \
+          case mr::Isa::sse42:  return name##_sse42(args...);                               \
+          default:              return name##_kernel(args...);                              \
+        }                                                                                   \
+      }
+#else
+  #define MR_MATH_KERNEL inline
+
+  #define MR_MATH_DISPATCHED(name)                                                          \
+    template <typename ...Args>                                                             \
+      void name(Args ...args) noexcept { name##_kernel(args...); }
+#endif
+
+#endif // __MR_DISPATCH_HPP_
@@ -0,0 +1,229 @@
+#ifndef __MR_EXPR_HPP_
+#define __MR_EXPR_HPP_
+
+#include "def.hpp"
+#include "row.hpp"
+#include "vec.hpp"
+
+// opt-in lazy expressions for Row and Vec
+// usage:
+//   mr::Vec3f r = mr::lazy(a) * b + mr::lazy(c) * d - e;   // fma(a, b, fma(c, d, -e))
+// operations on a 'mr::lazy' operand build a compile-time expression tree instead of temporaries;
+// the tree is evaluated on conversion to the operand type (or with mr::eval) and every product
+// in a chain of additions/subtractions is folded into the sum with a fused multiply-add.
+// a product of two plain Row/Vec operands (e.g. 'c * d' above without mr::lazy) is computed by
+// the eager operators before the tree sees it, so one factor of every product has to be lazy.
+// expressions store copies of their operands, so it is safe to keep them in 'auto' variables.
+
+namespace mr {
+  template <typename T>
+    concept LazyExprT = requires { requires std::remove_cvref_t<T>::is_lazy_expr; };
+
+  // common expression base
+  template <typename DerivedT, typename SimdT_, typename ResultT_>
+    struct LazyExpr {
+      using SimdT = SimdT_;
+      using ResultT = ResultT_;
+      static constexpr bool is_lazy_expr = true;
+
+      // evaluation on assignment
+      constexpr operator ResultT() const noexcept {
+        return mr::details::row_from_simd<ResultT>(_derived().eval());
+      }
+
+      // acc + this and acc - this (products and sums override them to fold into fma chains)
+      constexpr SimdT add_to(const SimdT &acc) const noexcept { return acc + _derived().eval(); }
+      constexpr SimdT sub_from(const SimdT &acc) const noexcept { return acc - _derived().eval(); }
+
+    private:
+      constexpr const DerivedT & _derived() const noexcept { return static_cast<const DerivedT &>(*this); }
+    };
+
+  // Row/Vec operand
+  template <typename SimdT, typename ResultT>
+    struct [[nodiscard]] LazyTerm : LazyExpr<LazyTerm<SimdT, ResultT>, SimdT, ResultT> {
+      SimdT _data;
+
+      constexpr LazyTerm(const SimdT &data) noexcept : _data(data) {}
+
+      constexpr SimdT eval() const noexcept { return _data; }
+    };
+
+  // scalar operand (broadcasted)
+  template <typename SimdT, typename ResultT>
+    struct [[nodiscard]] LazyScalar : LazyExpr<LazyScalar<SimdT, ResultT>, SimdT, ResultT> {
+      typename ResultT::ValueT _data;
+
+      constexpr LazyScalar(typename ResultT::ValueT data) noexcept : _data(data) {}
+
+      constexpr SimdT eval() const noexcept { return SimdT(_data); }
+    };
+
+  struct LazyAdd {};
+  struct LazySub {};
+  struct LazyMul {};
+  struct LazyDiv {};
+
+  template <typename OpT, typename L, typename R>
+    struct LazyBinary;
+
+  template <typename E>
+    struct LazyNeg;
+
+  namespace details {
+    // expression contains a product which can be folded into a sum with fma
+    template <typename E>
+      inline constexpr bool is_lazy_fusable = false;
+    template <typename L, typename R>
+      inline constexpr bool is_lazy_fusable<LazyBinary<LazyMul, L, R>> = true;
+    template <typename L, typename R>
+      inline constexpr bool is_lazy_fusable<LazyBinary<LazyAdd, L, R>> = is_lazy_fusable<L> || is_lazy_fusable<R>;
+    template <typename L, typename R>
+      inline constexpr bool is_lazy_fusable<LazyBinary<LazySub, L, R>> = is_lazy_fusable<L> || is_lazy_fusable<R>;
+    template <typename E>
+      inline constexpr bool is_lazy_fusable<LazyNeg<E>> = is_lazy_fusable<E>;
+  } // namespace details
+
+  template <typename OpT, typename L, typename R>
+    struct [[nodiscard]] LazyBinary : LazyExpr<LazyBinary<OpT, L, R>, typename L::SimdT, typename L::ResultT> {
+      using SimdT = typename L::SimdT;
+
+      L _lhs;
+      R _rhs;
+
+      constexpr LazyBinary(const L &lhs, const R &rhs) noexcept : _lhs(lhs), _rhs(rhs) {}
+
+      // sums start from a term without products, the products are then added one fma at a time
+      constexpr SimdT eval() const noexcept {
+        if constexpr (std::same_as<OpT, LazyAdd>) {
+          if constexpr (_is_fusable<L>) {
+            return _lhs.add_to(_rhs.eval());
+          } else if constexpr (_is_fusable<R>) {
+            return _rhs.add_to(_lhs.eval());
+          } else {
+            return _lhs.eval() + _rhs.eval();
+          }
+        } else if constexpr (std::same_as<OpT, LazySub>) {
+          if constexpr (_is_fusable<R>) {
+            return _rhs.sub_from(_lhs.eval());
+          } else if constexpr (_is_fusable<L>) {
+            return _lhs.add_to(-_rhs.eval());
+          } else {
+            return _lhs.eval() - _rhs.eval();
+          }
+        } else if constexpr (std::same_as<OpT, LazyMul>) {
+          return _lhs.eval() * _rhs.eval();
+        } else {
+          return _lhs.eval() / _rhs.eval();
+        }
+      }
+
+      constexpr SimdT add_to(const SimdT &acc) const noexcept {
+        if constexpr (std::same_as<OpT, LazyAdd>) {
+          return _rhs.add_to(_lhs.add_to(acc));
+        } else if constexpr (std::same_as<OpT, LazySub>) {
+          return _rhs.sub_from(_lhs.add_to(acc));
+        } else if constexpr (std::same_as<OpT, LazyMul>) {
+          return mr::details::fma_simd(_lhs.eval(), _rhs.eval(), acc);
+        } else {
+          return acc + eval();
+        }
+      }
+
+      constexpr SimdT sub_from(const SimdT &acc) const noexcept {
+        if constexpr (std::same_as<OpT, LazyAdd>) {
+          return _rhs.sub_from(_lhs.sub_from(acc));
+        } else if constexpr (std::same_as<OpT, LazySub>) {
+          return _rhs.add_to(_lhs.sub_from(acc));
+        } else if constexpr (std::same_as<OpT, LazyMul>) {
+          return mr::details::fma_simd(-_lhs.eval(), _rhs.eval(), acc);
+        } else {
+          return acc - eval();
+        }
+      }
+
+    private:
+      template <typename E>
+        static constexpr bool _is_fusable = mr::details::is_lazy_fusable<E>;
+    };
+
+  template <typename E>
+    struct [[nodiscard]] LazyNeg : LazyExpr<LazyNeg<E>, typename E::SimdT, typename E::ResultT> {
+      E _data;
+
+      constexpr LazyNeg(const E &data) noexcept : _data(data) {}
+
+      constexpr typename E::SimdT eval() const noexcept { return -_data.eval(); }
+
+      constexpr typename E::SimdT add_to(const typename E::SimdT &acc) const noexcept { return _data.sub_from(acc); }
+      constexpr typename E::SimdT sub_from(const typename E::SimdT &acc) const noexcept { return _data.add_to(acc); }
+    };
+
+  // starts lazy expression
+  template <RowLikeT D>
+    constexpr LazyTerm<typename D::SimdT, D> lazy(const D &v) noexcept {
+      return {mr::details::row_simd(v)};
+    }
+
+  // explicit evaluation
+  template <LazyExprT E>
+    constexpr typename E::ResultT eval(const E &e) noexcept {
+      return e;
+    }
+
+  namespace details {
+    template <typename E, typename X>
+      constexpr auto lazy_wrap(const X &x) noexcept {
+        if constexpr (LazyExprT<X>) {
+          static_assert(std::same_as<typename X::SimdT, typename E::SimdT>, "mixed lazy expression types");
+          return x;
+        } else if constexpr (ArithmeticT<X>) {
+          return LazyScalar<typename E::SimdT, typename E::ResultT>(static_cast<typename E::ResultT::ValueT>(x));
+        } else {
+          static_assert(std::same_as<typename X::SimdT, typename E::SimdT>, "mixed lazy expression types");
+          return LazyTerm<typename E::SimdT, typename E::ResultT>(row_simd(x));
+        }
+      }
+
+    template <typename OpT, typename L, typename R>
+      constexpr auto lazy_binary(const L &lhs, const R &rhs) noexcept {
+        using E = std::conditional_t<LazyExprT<L>, L, R>;
+        using WL = decltype(lazy_wrap<E>(lhs));
+        using WR = decltype(lazy_wrap<E>(rhs));
+        return LazyBinary<OpT, WL, WR>(lazy_wrap<E>(lhs), lazy_wrap<E>(rhs));
+      }
+  } // namespace details
+
+  // operand which can be mixed with a lazy expression
+  template <typename T>
+    concept LazyOperandT = LazyExprT<T> || RowLikeT<T> || ArithmeticT<T>;
+
+  // operators are only available when at least one side is already lazy,
+  // so eager Row/Vec arithmetic is unchanged
+  template <LazyOperandT L, LazyOperandT R> requires (LazyExprT<L> || LazyExprT<R>)
+    constexpr auto operator+(const L &lhs, const R &rhs) noexcept {
+      return mr::details::lazy_binary<LazyAdd>(lhs, rhs);
+    }
+
+  template <LazyOperandT L, LazyOperandT R> requires (LazyExprT<L> || LazyExprT<R>)
+    constexpr auto operator-(const L &lhs, const R &rhs) noexcept {
+      return mr::details::lazy_binary<LazySub>(lhs, rhs);
+    }
+
+  template <LazyOperandT L, LazyOperandT R> requires (LazyExprT<L> || LazyExprT<R>)
+    constexpr auto operator*(const L &lhs, const R &rhs) noexcept {
+      return mr::details::lazy_binary<LazyMul>(lhs, rhs);
+    }
+
+  template <LazyOperandT L, LazyOperandT R> requires (LazyExprT<L> || LazyExprT<R>)
+    constexpr auto operator/(const L &lhs, const R &rhs) noexcept {
+      return mr::details::lazy_binary<LazyDiv>(lhs, rhs);
+    }
+
+  template <LazyExprT E>
+    constexpr LazyNeg<E> operator-(const E &e) noexcept {
+      return {e};
+    }
+} // namespace mr
+
+#endif // __MR_EXPR_HPP_
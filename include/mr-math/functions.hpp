@@ -0,0 +1,218 @@
+#ifndef __MR_FUNCTIONS_HPP_
+#define __MR_FUNCTIONS_HPP_
+
+#include "def.hpp"
+#include "row.hpp"
+#include "dispatch.hpp"
+
+// element-wise functions for Row and Vec (fma, lerp/mix, step, smoothstep, min, max, saturate)
+// every function also has a batch overload over contiguous ranges:
+//   mr::lerp(a, b, 0.5f, out);
+// ranges of Row/Vec are processed one register per element,
+// ranges of scalars are processed in native (full width) registers;
+// batch overloads are runtime dispatched (see dispatch.hpp), so fma maps to vfmadd on fma cpus
+
+namespace mr {
+  namespace details {
+    // simd kernels (work for both SimdImpl<T, N> and NativeSimdImpl<T>)
+    template <typename S>
+      constexpr S lerp_kernel(const S &a, const S &b, const S &t) noexcept {
+        return fma_simd(t, b - a, a);
+      }
+
+    template <typename S>
+      constexpr S saturate_kernel(const S &x) noexcept {
+        return stdx::min(stdx::max(x, S(0)), S(1));
+      }
+
+    template <typename S>
+      constexpr S step_kernel(const S &edge, const S &x) noexcept {
+        return stdx::iif(x < edge, S(0), S(1));
+      }
+
+    template <typename S>
+      constexpr S smoothstep_kernel(const S &edge0, const S &edge1, const S &x) noexcept {
+        const S t = saturate_kernel((x - edge0) / (edge1 - edge0));
+        return t * t * fma_simd(S(-2), t, S(3));
+      }
+
+    template <typename R>
+      concept BatchRangeT = std::ranges::contiguous_range<R> &&
+        (RowLikeT<std::ranges::range_value_t<R>> || ArithmeticT<std::ranges::range_value_t<R>>);
+
+    // out[i] = kernel(in[i]...)
+    template <typename E, typename F, typename ...In>
+      MR_MATH_KERNEL void batch_map_kernel(E *dst, std::size_t size, F kernel, const In *...in) noexcept {
+        if constexpr (ArithmeticT<E>) {
+          using SimdT = NativeSimdImpl<E>;
+          constexpr size_t width = SimdT::size();
+          size_t i = 0;
+          for (; i + width <= size; i += width) {
+            kernel(SimdT(in + i, unaligned)...).store(dst + i, unaligned);
+          }
+          for (; i < size; i++) {
+            dst[i] = kernel(SimdImpl<E, 1>(in[i])...)[0];
+          }
+        } else {
+          for (size_t i = 0; i < size; i++) {
+            dst[i] = row_from_simd<E>(kernel(row_simd(in[i])...));
+          }
+        }
+      }
+    MR_MATH_DISPATCHED(batch_map)
+
+    template <typename O, typename F, typename ...In>
+      void batch_apply(O &&out, F &&kernel, const In &...in) noexcept {
+        const size_t n = std::ranges::size(out);
+        assert(((std::ranges::size(in) >= n) && ...));
+        batch_map(std::ranges::data(out), n, kernel, std::ranges::data(in)...);
+      }
+  } // namespace details
+
+  // a * b + c (single rounding on fma targets, see mr::details::fma_simd)
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D fma(const D &a, const D &b, const D &c) noexcept {
+      return mr::details::row_from_simd<D>(mr::details::fma_simd(mr::details::row_simd(a), mr::details::row_simd(b), mr::details::row_simd(c)));
+    }
+
+  // linear interpolation a + t * (b - a)
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D lerp(const D &a, const D &b, const D &t) noexcept {
+      return mr::details::row_from_simd<D>(
+        mr::details::lerp_kernel(mr::details::row_simd(a), mr::details::row_simd(b), mr::details::row_simd(t)));
+    }
+
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D lerp(const D &a, const D &b, typename D::ValueT t) noexcept {
+      return mr::details::row_from_simd<D>(
+        mr::details::lerp_kernel(mr::details::row_simd(a), mr::details::row_simd(b), typename D::SimdT(t)));
+    }
+
+  // glsl-style alias for lerp
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D mix(const D &a, const D &b, const D &t) noexcept {
+      return lerp(a, b, t);
+    }
+
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D mix(const D &a, const D &b, typename D::ValueT t) noexcept {
+      return lerp(a, b, t);
+    }
+
+  // 0 where x < edge, 1 otherwise
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D step(const D &edge, const D &x) noexcept {
+      return mr::details::row_from_simd<D>(mr::details::step_kernel(mr::details::row_simd(edge), mr::details::row_simd(x)));
+    }
+
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D step(typename D::ValueT edge, const D &x) noexcept {
+      return mr::details::row_from_simd<D>(mr::details::step_kernel(typename D::SimdT(edge), mr::details::row_simd(x)));
+    }
+
+  // hermite interpolation between 0 (x <= edge0) and 1 (x >= edge1)
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D smoothstep(const D &edge0, const D &edge1, const D &x) noexcept {
+      return mr::details::row_from_simd<D>(mr::details::smoothstep_kernel(
+        mr::details::row_simd(edge0), mr::details::row_simd(edge1), mr::details::row_simd(x)));
+    }
+
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D smoothstep(typename D::ValueT edge0, typename D::ValueT edge1, const D &x) noexcept {
+      return mr::details::row_from_simd<D>(mr::details::smoothstep_kernel(
+        typename D::SimdT(edge0), typename D::SimdT(edge1), mr::details::row_simd(x)));
+    }
+
+  // element-wise minimum/maximum
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D min(const D &a, const D &b) noexcept {
+      return mr::details::row_from_simd<D>(stdx::min(mr::details::row_simd(a), mr::details::row_simd(b)));
+    }
+
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D max(const D &a, const D &b) noexcept {
+      return mr::details::row_from_simd<D>(stdx::max(mr::details::row_simd(a), mr::details::row_simd(b)));
+    }
+
+  // clamp to [0, 1]
+  template <RowLikeT D>
+    [[nodiscard]] constexpr D saturate(const D &x) noexcept {
+      return mr::details::row_from_simd<D>(mr::details::saturate_kernel(mr::details::row_simd(x)));
+    }
+
+  // batch versions
+  template <mr::details::BatchRangeT A, mr::details::BatchRangeT B, mr::details::BatchRangeT C, mr::details::BatchRangeT O>
+    void fma(const A &a, const B &b, const C &c, O &&out) noexcept {
+      mr::details::batch_apply(out,
+        [](const auto &a, const auto &b, const auto &c) { return mr::details::fma_simd(a, b, c); },
+        a, b, c);
+    }
+
+  template <mr::details::BatchRangeT A, mr::details::BatchRangeT B, mr::details::BatchRangeT T, mr::details::BatchRangeT O>
+    void lerp(const A &a, const B &b, const T &t, O &&out) noexcept {
+      mr::details::batch_apply(out,
+        [](const auto &a, const auto &b, const auto &t) { return mr::details::lerp_kernel(a, b, t); },
+        a, b, t);
+    }
+
+  template <mr::details::BatchRangeT A, mr::details::BatchRangeT B, ArithmeticT T, mr::details::BatchRangeT O>
+    void lerp(const A &a, const B &b, T t, O &&out) noexcept {
+      mr::details::batch_apply(out,
+        [t](const auto &a, const auto &b) { return mr::details::lerp_kernel(a, b, std::remove_cvref_t<decltype(a)>(t)); },
+        a, b);
+    }
+
+  template <mr::details::BatchRangeT A, mr::details::BatchRangeT B, typename T, mr::details::BatchRangeT O>
+    void mix(const A &a, const B &b, const T &t, O &&out) noexcept {
+      lerp(a, b, t, out);
+    }
+
+  template <ArithmeticT T, mr::details::BatchRangeT X, mr::details::BatchRangeT O>
+    void step(T edge, const X &x, O &&out) noexcept {
+      mr::details::batch_apply(out,
+        [edge](const auto &x) { return mr::details::step_kernel(std::remove_cvref_t<decltype(x)>(edge), x); },
+        x);
+    }
+
+  template <ArithmeticT T, mr::details::BatchRangeT X, mr::details::BatchRangeT O>
+    void smoothstep(T edge0, T edge1, const X &x, O &&out) noexcept {
+      mr::details::batch_apply(out,
+        [edge0, edge1](const auto &x) {
+          using S = std::remove_cvref_t<decltype(x)>;
+          return mr::details::smoothstep_kernel(S(edge0), S(edge1), x);
+        },
+        x);
+    }
+
+  template <mr::details::BatchRangeT A, mr::details::BatchRangeT B, mr::details::BatchRangeT O>
+    void min(const A &a, const B &b, O &&out) noexcept {
+      mr::details::batch_apply(out, [](const auto &a, const auto &b) { return stdx::min(a, b); }, a, b);
+    }
+
+  template <mr::details::BatchRangeT A, mr::details::BatchRangeT B, mr::details::BatchRangeT O>
+    void max(const A &a, const B &b, O &&out) noexcept {
+      mr::details::batch_apply(out, [](const auto &a, const auto &b) { return stdx::max(a, b); }, a, b);
+    }
+
+  template <mr::details::BatchRangeT X, mr::details::BatchRangeT O>
+    void saturate(const X &x, O &&out) noexcept {
+      mr::details::batch_apply(out, [](const auto &x) { return mr::details::saturate_kernel(x); }, x);
+    }
+
+  // out[i] = in[i].swizzle<I...>() (e.g. mr::swizzle<2, 1, 0>(rgb, bgr))
+  template <std::size_t ...I, mr::details::BatchRangeT X, mr::details::BatchRangeT O>
+    requires RowLikeT<std::ranges::range_value_t<X>> && RowLikeT<std::ranges::range_value_t<O>> &&
+      (std::ranges::range_value_t<O>::size == sizeof...(I)) && ((I < std::ranges::range_value_t<X>::size) && ...)
+    void swizzle(const X &in, O &&out) noexcept {
+      using E = std::ranges::range_value_t<X>;
+      const size_t n = std::ranges::size(out);
+      assert(std::ranges::size(in) >= n);
+      const E *src = std::ranges::data(in);
+      auto *dst = std::ranges::data(out);
+      for (size_t i = 0; i < n; i++) {
+        dst[i] = mr::details::row_from_simd<std::ranges::range_value_t<O>>(mr::details::swizzle_simd<I...>(src[i]));
+      }
+    }
+} // namespace mr
+
+#endif // __MR_FUNCTIONS_HPP_
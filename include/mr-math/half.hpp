@@ -0,0 +1,286 @@
+#ifndef __MR_HALF_HPP_
+#define __MR_HALF_HPP_
+
+#include "def.hpp"
+#include "vec.hpp"
+#include "color.hpp"
+#include "dispatch.hpp"
+
+// half precision (IEEE 754 binary16) storage
+// halves are storage only: widen to float types for arithmetic
+//   std::vector<mr::Vec3h> positions = ...;   // 6 bytes per vector
+//   mr::convert(positions, positions_f);      // bulk widening (f16c when available)
+
+namespace mr {
+  // forward declarations
+  struct Half;
+  template <std::size_t N> requires (N >= 2)
+    struct HalfVec;
+
+  // common aliases
+  using Vec2h = HalfVec<2>;
+  using Vec3h = HalfVec<3>;
+  using Vec4h = HalfVec<4>;
+
+  namespace details {
+    constexpr float half_bits_to_float(uint16_t h) noexcept {
+      const uint32_t sign = uint32_t(h & 0x8000) << 16;
+      const uint32_t exp = (h >> 10) & 0x1F;
+      const uint32_t mant = h & 0x3FF;
+
+      if (exp == 0) {
+        // zero or subnormal (exactly representable in float)
+        const float value = mant * (1.f / 16777216.f);
+        return sign ? -value : value;
+      }
+      if (exp == 0x1F) {
+        // infinity or nan
+        return std::bit_cast<float>(sign | 0x7F80'0000 | (mant << 13));
+      }
+      return std::bit_cast<float>(sign | ((exp + 112) << 23) | (mant << 13));
+    }
+
+    // rounds to nearest even
+    constexpr uint16_t float_to_half_bits(float f) noexcept {
+      const uint32_t bits = std::bit_cast<uint32_t>(f);
+      const uint16_t sign = (bits >> 16) & 0x8000;
+      uint32_t abs = bits & 0x7FFF'FFFF;
+
+      if (abs >= 0x7F80'0000) {
+        // infinity or nan (nan stays quiet)
+        return sign | 0x7C00 | (abs > 0x7F80'0000 ? 0x200 | ((abs >> 13) & 0x3FF) : 0);
+      }
+      if (abs >= 0x477F'F000) {
+        // rounds to infinity
+        return sign | 0x7C00;
+      }
+      if (abs < 0x3880'0000) {
+        // subnormal: let the fpu round by adding 0.5 (its ulp is the half subnormal step)
+        const float rounded = std::bit_cast<float>(abs) + 0.5f;
+        return sign | uint16_t(std::bit_cast<uint32_t>(rounded) - 0x3F00'0000);
+      }
+      // rebias exponent and round mantissa
+      abs += 0xC800'0FFF + ((abs >> 13) & 1);
+      return sign | uint16_t(abs >> 13);
+    }
+  } // namespace details
+
+  // single half precision value
+  struct [[nodiscard]] Half {
+  public:
+    uint16_t _data = 0;
+
+    constexpr Half() noexcept = default;
+
+    constexpr Half(float f) noexcept : _data(mr::details::float_to_half_bits(f)) {}
+
+    static constexpr Half from_bits(uint16_t bits) noexcept {
+      Half h;
+      h._data = bits;
+      return h;
+    }
+
+    constexpr operator float() const noexcept {
+      return mr::details::half_bits_to_float(_data);
+    }
+
+    [[nodiscard]] constexpr uint16_t bits() const noexcept { return _data; }
+
+    // bitwise comparison
+    constexpr bool operator==(const Half &other) const noexcept = default;
+
+    friend std::ostream & operator<<(std::ostream &os, const Half &h) noexcept {
+      os << float(h);
+      return os;
+    }
+  };
+
+  // Vec<float, N> stored in half precision (6 bytes for Vec3h)
+  template <std::size_t N> requires (N >= 2)
+    struct [[nodiscard]] HalfVec {
+    public:
+      using ValueT = Half;
+      using VecT = Vec<float, N>;
+      static constexpr size_t size = N;
+
+      std::array<Half, N> _data {};
+
+      constexpr HalfVec() noexcept = default;
+
+      // from elements constructor
+      template <ArithmeticT... Args>
+      requires (sizeof...(Args) == N)
+        constexpr HalfVec(Args... args) noexcept : _data {Half(static_cast<float>(args))...} {}
+
+      // from vector constructor
+      constexpr HalfVec(const VecT &v) noexcept {
+        for (size_t i = 0; i < N; i++) {
+          _data[i] = v[i];
+        }
+      }
+
+      constexpr HalfVec(const Color &c) noexcept requires (N == 4)
+        : HalfVec(c.r(), c.g(), c.b(), c.a()) {}
+
+      constexpr operator VecT() const noexcept {
+        return typename VecT::RowT(SimdImpl<float, N>([this](size_t i) { return float(_data[i]); }));
+      }
+
+      operator Color() const noexcept requires (N == 4) {
+        return Color(VecT(*this));
+      }
+
+      // setters
+      constexpr void set(size_t i, float value) noexcept { _data[i] = value; }
+      constexpr void x(float x) noexcept requires (N >= 1) { _data[0] = x; }
+      constexpr void y(float y) noexcept requires (N >= 2) { _data[1] = y; }
+      constexpr void z(float z) noexcept requires (N >= 3) { _data[2] = z; }
+      constexpr void w(float w) noexcept requires (N >= 4) { _data[3] = w; }
+
+      // getters
+      [[nodiscard]] constexpr float x() const noexcept requires (N >= 1) { return _data[0]; }
+      [[nodiscard]] constexpr float y() const noexcept requires (N >= 2) { return _data[1]; }
+      [[nodiscard]] constexpr float z() const noexcept requires (N >= 3) { return _data[2]; }
+      [[nodiscard]] constexpr float w() const noexcept requires (N >= 4) { return _data[3]; }
+      [[nodiscard]] constexpr float operator[](std::size_t i) const { return _data[i]; }
+
+      // structured binding support
+      template <size_t I> requires (I < N) constexpr float get() const { return _data[I]; }
+
+      constexpr bool operator==(const HalfVec &other) const noexcept = default;
+
+      friend std::ostream & operator<<(std::ostream &os, const HalfVec &v) noexcept {
+        os << VecT(v);
+        return os;
+      }
+    };
+
+  // layout guarantees (required by batch conversions)
+  static_assert(sizeof(Half) == 2);
+  static_assert(sizeof(Vec3h) == 3 * sizeof(Half));
+  static_assert(sizeof(std::array<Vec4h, 2>) == 8 * sizeof(Half));
+  static_assert(std::is_trivially_copyable_v<Vec3h>);
+  static_assert(std::is_standard_layout_v<Half> && std::is_standard_layout_v<Vec3h>);
+
+  namespace details {
+#if MR_MATH_RUNTIME_DISPATCH
+    [[gnu::target("avx2,fma,f16c")]]
+      inline void half_to_float_f16c(const uint16_t *in, float *out, std::size_t size) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+          const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+          _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+        }
+        for (; i < size; i++) {
+          out[i] = half_bits_to_float(in[i]);
+        }
+      }
+
+    [[gnu::target("avx2,fma,f16c")]]
+      inline void float_to_half_f16c(const float *in, uint16_t *out, std::size_t size) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+          const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+        }
+        for (; i < size; i++) {
+          out[i] = float_to_half_bits(in[i]);
+        }
+      }
+#endif
+
+    // f16c path is used for mr::Isa::avx2 and wider (see dispatch.hpp)
+    inline void half_to_float(const uint16_t *in, float *out, std::size_t size) noexcept {
+#if MR_MATH_RUNTIME_DISPATCH
+      if (active_isa() >= Isa::avx2) {
+        half_to_float_f16c(in, out, size);
+        return;
+      }
+#endif
+      for (size_t i = 0; i < size; i++) {
+        out[i] = half_bits_to_float(in[i]);
+      }
+    }
+
+    inline void float_to_half(const float *in, uint16_t *out, std::size_t size) noexcept {
+#if MR_MATH_RUNTIME_DISPATCH
+      if (active_isa() >= Isa::avx2) {
+        float_to_half_f16c(in, out, size);
+        return;
+      }
+#endif
+      for (size_t i = 0; i < size; i++) {
+        out[i] = float_to_half_bits(in[i]);
+      }
+    }
+
+    // widens packed halves block by block and loads every vector from the float buffer
+    template <std::size_t N, typename DstT>
+      void convert_from_half(std::span<const HalfVec<N>> in, std::span<DstT> out) noexcept {
+        assert(out.size() >= in.size());
+        constexpr size_t block = 16;
+        std::array<float, block * N> buffer;
+        for (size_t i = 0; i < in.size(); i += block) {
+          const size_t count = std::min(block, in.size() - i);
+          half_to_float(reinterpret_cast<const uint16_t *>(in.data() + i), buffer.data(), count * N);
+          for (size_t j = 0; j < count; j++) {
+            out[i + j] = DstT(Vec<float, N>::load(buffer.data() + j * N));
+          }
+        }
+      }
+
+    template <std::size_t N, typename SrcT>
+      void convert_to_half(std::span<const SrcT> in, std::span<HalfVec<N>> out) noexcept {
+        assert(out.size() >= in.size());
+        constexpr size_t block = 16;
+        std::array<float, block * N> buffer;
+        for (size_t i = 0; i < in.size(); i += block) {
+          const size_t count = std::min(block, in.size() - i);
+          for (size_t j = 0; j < count; j++) {
+            for (size_t c = 0; c < N; c++) {
+              buffer[j * N + c] = in[i + j][c];
+            }
+          }
+          float_to_half(buffer.data(), reinterpret_cast<uint16_t *>(out.data() + i), count * N);
+        }
+      }
+  } // namespace details
+
+  // batch conversions
+  inline void convert(std::span<const Half> in, std::span<float> out) noexcept {
+    assert(out.size() >= in.size());
+    mr::details::half_to_float(reinterpret_cast<const uint16_t *>(in.data()), out.data(), in.size());
+  }
+
+  inline void convert(std::span<const float> in, std::span<Half> out) noexcept {
+    assert(out.size() >= in.size());
+    mr::details::float_to_half(in.data(), reinterpret_cast<uint16_t *>(out.data()), in.size());
+  }
+
+  inline void convert(std::span<const Vec2h> in, std::span<Vec2f> out) noexcept { mr::details::convert_from_half<2>(in, out); }
+  inline void convert(std::span<const Vec3h> in, std::span<Vec3f> out) noexcept { mr::details::convert_from_half<3>(in, out); }
+  inline void convert(std::span<const Vec4h> in, std::span<Vec4f> out) noexcept { mr::details::convert_from_half<4>(in, out); }
+  inline void convert(std::span<const Vec4h> in, std::span<Color> out) noexcept { mr::details::convert_from_half<4>(in, out); }
+
+  inline void convert(std::span<const Vec2f> in, std::span<Vec2h> out) noexcept { mr::details::convert_to_half<2>(in, out); }
+  inline void convert(std::span<const Vec3f> in, std::span<Vec3h> out) noexcept { mr::details::convert_to_half<3>(in, out); }
+  inline void convert(std::span<const Vec4f> in, std::span<Vec4h> out) noexcept { mr::details::convert_to_half<4>(in, out); }
+  inline void convert(std::span<const Color> in, std::span<Vec4h> out) noexcept { mr::details::convert_to_half<4>(in, out); }
+} // namespace mr
+
+#ifdef __cpp_structured_bindings
+// specializations for structured binding support
+namespace std
+{
+  template <std::size_t N>
+  struct tuple_size<mr::HalfVec<N>>
+      : std::integral_constant<size_t, N> {};
+
+  template <std::size_t N, std::size_t I>
+  struct tuple_element<I, mr::HalfVec<N>> {
+    using type = float;
+  };
+}
+#endif
+
+#endif // __MR_HALF_HPP_
@@ -0,0 +1,189 @@
+#ifndef __MR_HIERARCHY_HPP_
+#define __MR_HIERARCHY_HPP_
+
+#include "def.hpp"
+#include "matr.hpp"
+#include "affine.hpp"
+#include "reduce.hpp"
+#include "transform.hpp"
+
+// flat transform hierarchy, world(i) = local(i) * world(parent(i))
+//   mr::Hierarchyf scene;
+//   size_t root = scene.add(mr::Affine3f::translate({0, 1, 0}));
+//   size_t arm = scene.add(mr::Affine3f::scale({2, 2, 2}), root);
+//   scene.set_local(root, ...);          // marks the whole subtree for update
+//   scene.update(mr::parallel);          // only changed subtrees are recomputed
+//   mr::Matr4f m = scene.world(arm);
+// nodes are processed level by level (sorted by depth), so every parent world is final before
+// its children are composed in place; large levels may be split across threads
+
+namespace mr {
+  // forward declarations
+  template <std::floating_point T>
+    struct Hierarchy;
+
+  // common aliases
+  using Hierarchyf = Hierarchy<float>;
+  using Hierarchyd = Hierarchy<double>;
+
+  namespace details {
+    // levels with fewer updated nodes than 2 * this are never split across threads
+    inline constexpr std::size_t parallel_hierarchy_chunk = 1 << 12;
+  } // namespace details
+
+  template <std::floating_point T>
+    struct [[nodiscard]] Hierarchy {
+    public:
+      using ValueT = T;
+      using AffineT = Affine3<T>;
+
+      static constexpr std::size_t no_parent = std::size_t(-1);
+
+      constexpr Hierarchy() noexcept = default;
+
+      // parent must be added before its children (no_parent for roots)
+      // returns index of the new node
+      std::size_t add(const AffineT &local, std::size_t parent = no_parent) noexcept {
+        assert(parent == no_parent || parent < size());
+        _locals.push_back(local);
+        _worlds.push_back(local);
+        _parents.push_back(parent);
+        _depths.push_back(parent == no_parent ? 0 : _depths[parent] + 1);
+        _dirty.push_back(true);
+        _sorted = false;
+        return size() - 1;
+      }
+
+      std::size_t add(const Matr4<T> &local, std::size_t parent = no_parent) noexcept {
+        return add(AffineT(local), parent);
+      }
+
+      void reserve(std::size_t count) noexcept {
+        _locals.reserve(count);
+        _worlds.reserve(count);
+        _parents.reserve(count);
+        _depths.reserve(count);
+        _dirty.reserve(count);
+      }
+
+      void clear() noexcept {
+        *this = Hierarchy();
+      }
+
+      void set_local(std::size_t i, const AffineT &local) noexcept {
+        _locals[i] = local;
+        _dirty[i] = true;
+      }
+
+      void set_local(std::size_t i, const Matr4<T> &local) noexcept {
+        set_local(i, AffineT(local));
+      }
+
+      // getters
+      [[nodiscard]] std::size_t size() const noexcept { return _locals.size(); }
+      [[nodiscard]] std::size_t parent(std::size_t i) const noexcept { return _parents[i]; }
+      [[nodiscard]] std::size_t depth(std::size_t i) const noexcept { return _depths[i]; }
+      [[nodiscard]] bool dirty(std::size_t i) const noexcept { return _dirty[i]; }
+      [[nodiscard]] const AffineT & local(std::size_t i) const noexcept { return _locals[i]; }
+
+      // valid after update()
+      [[nodiscard]] const AffineT & world(std::size_t i) const noexcept { return _worlds[i]; }
+      [[nodiscard]] std::span<const AffineT> worlds() const noexcept { return _worlds; }
+
+      // recomputes world transforms of dirty nodes and their descendants (mr::parallel splits large levels)
+      // returns number of recomputed nodes
+      template <std::same_as<ParallelTag> ...Policy>
+        std::size_t update(Policy ...) noexcept {
+          if (!_sorted) {
+            _sort_by_depth();
+          }
+
+          // gather changed nodes level by level (a parent is always visited before its children)
+          _updated.clear();
+          _updated_levels.assign(1, 0);
+          for (size_t level = 0; level + 1 < _levels.size(); level++) {
+            for (size_t k = _levels[level]; k < _levels[level + 1]; k++) {
+              const size_t i = _order[k];
+              const size_t p = _parents[i];
+              if (_dirty[i] || (p != no_parent && _dirty[p])) {
+                _dirty[i] = true;
+                _updated.push_back(i);
+              }
+            }
+            _updated_levels.push_back(_updated.size());
+          }
+
+          for (size_t level = 0; level + 1 < _updated_levels.size(); level++) {
+            const size_t *nodes = _updated.data() + _updated_levels[level];
+            const size_t count = _updated_levels[level + 1] - _updated_levels[level];
+            if (level == 0) {
+              // depth 0 nodes are roots
+              for (size_t k = 0; k < count; k++) {
+                _worlds[nodes[k]] = _locals[nodes[k]];
+              }
+              continue;
+            }
+
+            if (sizeof...(Policy) == 0 || count < 2 * mr::details::parallel_hierarchy_chunk) {
+              _update_nodes(nodes, 0, count);
+            } else {
+              mr::details::parallel_for(count, mr::details::parallel_hierarchy_chunk, [&](size_t begin, size_t end) {
+                _update_nodes(nodes, begin, end);
+              });
+            }
+          }
+
+          for (size_t i : _updated) {
+            _dirty[i] = false;
+          }
+          return _updated.size();
+        }
+
+    private:
+      std::vector<AffineT> _locals;
+      std::vector<AffineT> _worlds;
+      std::vector<std::size_t> _parents;
+      std::vector<std::size_t> _depths;
+      std::vector<uint8_t> _dirty;
+
+      // node indices sorted by depth, level d is _order[_levels[d] .. _levels[d + 1])
+      std::vector<std::size_t> _order;
+      std::vector<std::size_t> _levels;
+      bool _sorted = true;
+
+      // nodes recomputed by the last update() (same layout as _order/_levels)
+      std::vector<std::size_t> _updated;
+      std::vector<std::size_t> _updated_levels;
+
+      // counting sort, nodes keep their insertion order within a level
+      void _sort_by_depth() noexcept {
+        const size_t max_depth = size() == 0 ? 0 : *std::ranges::max_element(_depths) + 1;
+        _levels.assign(max_depth + 1, 0);
+        for (size_t d : _depths) {
+          _levels[d + 1]++;
+        }
+        std::partial_sum(_levels.begin(), _levels.end(), _levels.begin());
+
+        std::vector<size_t> next(_levels.begin(), _levels.end() - 1);
+        _order.resize(size());
+        for (size_t i = 0; i < size(); i++) {
+          _order[next[_depths[i]]++] = i;
+        }
+        _sorted = true;
+      }
+
+      // 'nodes' all have parents, which are already up to date
+      void _update_nodes(const size_t *nodes, size_t begin, size_t end) noexcept {
+        constexpr size_t distance = mr::details::multiply_prefetch_distance;
+        for (size_t k = begin; k < end; k++) {
+          if (k + distance < end) {
+            mr::details::prefetch(&_locals[nodes[k + distance]]);
+          }
+          const size_t i = nodes[k];
+          _worlds[i] = _locals[i] * _worlds[_parents[i]];
+        }
+      }
+    };
+} // namespace mr
+
+#endif // __MR_HIERARCHY_HPP_
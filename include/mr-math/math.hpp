@@ -6,11 +6,25 @@
 #include "rot.hpp"
 #include "norm.hpp"
 #include "matr.hpp"
+#include "affine.hpp"
 #include "quat.hpp"
 #include "units.hpp"
 #include "camera.hpp"
 #include "bound_box.hpp"
 #include "color.hpp"
+#include "stream.hpp"
+#include "transform.hpp"
+#include "storage.hpp"
+#include "expr.hpp"
+#include "functions.hpp"
+#include "rsqrt.hpp"
+#include "dispatch.hpp"
+#include "reduce.hpp"
+#include "half.hpp"
+#include "octahedral.hpp"
+#include "wide.hpp"
+#include "hierarchy.hpp"
+#include "trs.hpp"
 
 #ifndef NDEBUG
   #include "debug.hpp"
@@ -7,50 +7,294 @@
 
 namespace mr
 {
-  // forward declarations
-  template <ArithmeticT T, std::size_t N>
-    struct Matr;
+  namespace details {
+    // 3d cross product of registers (w of the result is 0)
+    template <typename T>
+      constexpr SimdImpl<T, 4> cross_simd(const SimdImpl<T, 4> &a, const SimdImpl<T, 4> &b) noexcept {
+        return shuffle_simd<1, 2, 0, 3>(a, a) * shuffle_simd<2, 0, 1, 3>(b, b) -
+               shuffle_simd<2, 0, 1, 3>(a, a) * shuffle_simd<1, 2, 0, 3>(b, b);
+      }
+
+    // determinant of the 4x4 matrix with rows r0, r1, r2, r3
+    template <typename T>
+      constexpr T determinant_simd(const SimdImpl<T, 4> &r0, const SimdImpl<T, 4> &r1,
+                                   const SimdImpl<T, 4> &r2, const SimdImpl<T, 4> &r3) noexcept {
+        using SimdT = SimdImpl<T, 4>;
+        // minors of adjacent columns: (m01, m12, m23, m30)
+        const SimdT s1 = r0 * shuffle_simd<1, 2, 3, 0>(r1, r1) - shuffle_simd<1, 2, 3, 0>(r0, r0) * r1;
+        const SimdT c1 = r2 * shuffle_simd<1, 2, 3, 0>(r3, r3) - shuffle_simd<1, 2, 3, 0>(r2, r2) * r3;
+        // minors of opposite columns: (m02, m13, -m02, -m13)
+        const SimdT s2 = r0 * shuffle_simd<2, 3, 0, 1>(r1, r1) - shuffle_simd<2, 3, 0, 1>(r0, r0) * r1;
+        const SimdT c2 = r2 * shuffle_simd<2, 3, 0, 1>(r3, r3) - shuffle_simd<2, 3, 0, 1>(r2, r2) * r3;
+
+        // s01 * c23 - s12 * c30 + s23 * c01 - s30 * c12 - s02 * c13 - s13 * c02
+        const SimdT sign = SimdT([](size_t i) { return i % 2 == 0 ? T(1) : T(-1); });
+        return (s1 * shuffle_simd<2, 3, 0, 1>(c1, c1) * sign).sum() - (s2[0] * c2[1] + s2[1] * c2[0]);
+      }
+
+    // inverse transpose of the 3x3 matrix with xyz rows r0, r1, r2 (w of the results is 0)
+    // rotation with uniform scale s is detected (orthogonal rows of equal length) and gives rows / s^2,
+    // otherwise rows of the adjugate are cross products of the other two rows
+    template <typename T>
+      constexpr std::array<SimdImpl<T, 4>, 3> normal_rows_simd(
+          const SimdImpl<T, 4> &m0, const SimdImpl<T, 4> &m1, const SimdImpl<T, 4> &m2) noexcept {
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT r0 = shuffle_simd<0, 1, 2, 4>(m0, SimdT(0));
+        const SimdT r1 = shuffle_simd<0, 1, 2, 4>(m1, SimdT(0));
+        const SimdT r2 = shuffle_simd<0, 1, 2, 4>(m2, SimdT(0));
+
+        const T l0 = (r0 * r0).sum();
+        const T tol = l0 * 16 * std::numeric_limits<T>::epsilon();
+        const auto small = [tol](T x) { return std::abs(x) <= tol; };
+        if (small((r1 * r1).sum() - l0) && small((r2 * r2).sum() - l0) &&
+            small((r0 * r1).sum()) && small((r0 * r2).sum()) && small((r1 * r2).sum())) {
+          const T inv_l = T(1) / l0;
+          return {r0 * inv_l, r1 * inv_l, r2 * inv_l};
+        }
+
+        const SimdT c0 = cross_simd(r1, r2);
+        const SimdT c1 = cross_simd(r2, r0);
+        const SimdT c2 = cross_simd(r0, r1);
+        const T inv_det = T(1) / (r0 * c0).sum();
+        return {c0 * inv_det, c1 * inv_det, c2 * inv_det};
+      }
+
+    // cross product of 3 element registers
+    template <typename T>
+      constexpr SimdImpl<T, 3> cross3_simd(const SimdImpl<T, 3> &a, const SimdImpl<T, 3> &b) noexcept {
+        return shuffle_simd<1, 2, 0>(a, a) * shuffle_simd<2, 0, 1>(b, b) -
+               shuffle_simd<2, 0, 1>(a, a) * shuffle_simd<1, 2, 0>(b, b);
+      }
+
+    // 2x2 matrices stored in registers as (m00, m01, m10, m11)
+    // a * b
+    template <typename T>
+      constexpr SimdImpl<T, 4> mat2_mul(const SimdImpl<T, 4> &a, const SimdImpl<T, 4> &b) noexcept {
+        return a * shuffle_simd<0, 3, 0, 3>(b, b) + shuffle_simd<1, 0, 3, 2>(a, a) * shuffle_simd<2, 1, 2, 1>(b, b);
+      }
+
+    // adj(a) * b
+    template <typename T>
+      constexpr SimdImpl<T, 4> mat2_adj_mul(const SimdImpl<T, 4> &a, const SimdImpl<T, 4> &b) noexcept {
+        return shuffle_simd<3, 3, 0, 0>(a, a) * b - shuffle_simd<1, 1, 2, 2>(a, a) * shuffle_simd<2, 3, 0, 1>(b, b);
+      }
+
+    // a * adj(b)
+    template <typename T>
+      constexpr SimdImpl<T, 4> mat2_mul_adj(const SimdImpl<T, 4> &a, const SimdImpl<T, 4> &b) noexcept {
+        return a * shuffle_simd<3, 0, 3, 0>(b, b) - shuffle_simd<1, 0, 3, 2>(a, a) * shuffle_simd<2, 1, 2, 1>(b, b);
+      }
+  } // namespace details
+
+  // forward declarations (Matr<T, R, C = R> is declared in vec.hpp)
 
   // common aliases
+  template <ArithmeticT T>
+    using Matr2 = Matr<T, 2>;
+  template <ArithmeticT T>
+    using Matr3 = Matr<T, 3>;
   template <ArithmeticT T>
     using Matr4 = Matr<T, 4>;
 
+  using Matr2f = Matr2<float>;
+  using Matr2d = Matr2<double>;
+  using Matr3f = Matr3<float>;
+  using Matr3d = Matr3<double>;
   using Matr4f = Matr4<float>;
   using Matr4d = Matr4<double>;
   using Matr4i = Matr4<int>;
   using Matr4u = Matr4<uint32_t>;
 
-  template <ArithmeticT T, std::size_t N>
+  namespace details {
+    // f(std::integral_constant<std::size_t, I>{}) for I in [0, Count) without a runtime loop
+    template <std::size_t Count, typename F>
+      constexpr void unroll(F &&f) noexcept {
+        [&f]<std::size_t ...I>(std::index_sequence<I...>) {
+          (f(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<Count>{});
+      }
+
+    // sum of rows[k] * coefs[k] (row vector times matrix)
+    template <typename T, std::size_t C, std::size_t K>
+      constexpr SimdImpl<T, K> combine_rows(const SimdImpl<T, C> &coefs, const std::array<Row<T, K>, C> &rows) noexcept {
+        return [&]<std::size_t ...I>(std::index_sequence<I...>) {
+          return ((rows[I]._data * coefs[I]) + ...);
+        }(std::make_index_sequence<C>{});
+      }
+
+    // TRS kernels work for scalars and for registers holding one component of several transforms
+    template <typename S>
+      constexpr S trs_sqrt(const S &x) noexcept {
+        if constexpr (ArithmeticT<S>) {
+          return std::sqrt(x);
+        } else {
+          return stdx::sqrt(x);
+        }
+      }
+
+    // cond ? a : b
+    template <typename M, typename S>
+      constexpr S trs_select(const M &cond, const S &a, const S &b) noexcept {
+        if constexpr (ArithmeticT<S>) {
+          return cond ? a : b;
+        } else {
+          return stdx::iif(cond, a, b);
+        }
+      }
+
+    template <typename S>
+      using Trs3 = std::array<S, 3>;
+
+    template <typename S>
+      constexpr S trs_dot(const Trs3<S> &a, const Trs3<S> &b) noexcept {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+      }
+
+    // sine and cosine from one evaluation (shared range reduction)
+    template <typename S>
+      constexpr void sincos(const S &x, S &s, S &c) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        if constexpr (std::same_as<S, float>) {
+          __builtin_sincosf(x, &s, &c);
+          return;
+        } else if constexpr (std::same_as<S, double>) {
+          __builtin_sincos(x, &s, &c);
+          return;
+        }
+#endif
+        if constexpr (ArithmeticT<S>) {
+          s = std::sin(x);
+          c = std::cos(x);
+        } else {
+          stdx::sincos(x, &s, &c);
+        }
+      }
+
+    // upper 3x3 of the rotation by angle with sine si and cosine co around unit axis n (Rodrigues)
+    // rows are (n[i] * (1 - co)) * n + skew part, same orientation as Matr4::rotate
+    template <typename S>
+      constexpr std::array<Trs3<S>, 3> rotate_kernel(const Trs3<S> &n, const S &si, const S &co) noexcept {
+        const S nco = S(1) - co;
+        const S x = n[0] * nco, y = n[1] * nco, z = n[2] * nco;
+        const S xy = x * n[1], xz = x * n[2], yz = y * n[2];
+        const S sx = n[0] * si, sy = n[1] * si, sz = n[2] * si;
+        return {{
+          {x * n[0] + co, xy - sz, xz + sy},
+          {xy + sz, y * n[1] + co, yz - sx},
+          {xz - sy, yz + sx, z * n[2] + co},
+        }};
+      }
+
+    // upper 3x3 of scale(s) * rotation(q) with q = (x, y, z, w) normalized
+    template <typename S>
+      constexpr std::array<Trs3<S>, 3> trs_compose_kernel(const std::array<S, 4> &q, const Trs3<S> &s) noexcept {
+        const auto &[x, y, z, w] = q;
+        const S x2 = x + x, y2 = y + y, z2 = z + z;
+        const S xx = x * x2, yy = y * y2, zz = z * z2;
+        const S xy = x * y2, xz = x * z2, yz = y * z2;
+        const S wx = w * x2, wy = w * y2, wz = w * z2;
+        return {{
+          {(S(1) - yy - zz) * s[0], (xy + wz) * s[0], (xz - wy) * s[0]},
+          {(xy - wz) * s[1], (S(1) - xx - zz) * s[1], (yz + wx) * s[1]},
+          {(xz + wy) * s[2], (yz - wx) * s[2], (S(1) - xx - yy) * s[2]},
+        }};
+      }
+
+    // inverse of trs_compose_kernel, m is the upper 3x3 of a matrix
+    // rows are normalized for the scale (and orthogonalized first if 'orthogonalize', which drops shear),
+    // a mirrored basis gets negative x scale, rotation is converted branchlessly (Day, 2015) with w >= 0
+    template <typename S>
+      constexpr void trs_decompose_kernel(std::array<Trs3<S>, 3> m, bool orthogonalize,
+                                          std::array<S, 4> &q, Trs3<S> &s) noexcept {
+        const auto scale_row = [](Trs3<S> &r, const S &k) { r = {r[0] * k, r[1] * k, r[2] * k}; };
+        const auto sub_row = [](Trs3<S> &r, const Trs3<S> &o, const S &k) {
+          r = {r[0] - o[0] * k, r[1] - o[1] * k, r[2] - o[2] * k};
+        };
+
+        s[0] = trs_sqrt(trs_dot(m[0], m[0]));
+        scale_row(m[0], S(1) / s[0]);
+        if (orthogonalize) {
+          sub_row(m[1], m[0], trs_dot(m[0], m[1]));
+        }
+        s[1] = trs_sqrt(trs_dot(m[1], m[1]));
+        scale_row(m[1], S(1) / s[1]);
+        if (orthogonalize) {
+          sub_row(m[2], m[0], trs_dot(m[0], m[2]));
+          sub_row(m[2], m[1], trs_dot(m[1], m[2]));
+        }
+        s[2] = trs_sqrt(trs_dot(m[2], m[2]));
+        scale_row(m[2], S(1) / s[2]);
+
+        const Trs3<S> c12 {
+          m[1][1] * m[2][2] - m[1][2] * m[2][1],
+          m[1][2] * m[2][0] - m[1][0] * m[2][2],
+          m[1][0] * m[2][1] - m[1][1] * m[2][0]
+        };
+        const S sign = trs_select(trs_dot(m[0], c12) < S(0), S(-1), S(1));
+        s[0] *= sign;
+        scale_row(m[0], sign);
+
+        // largest of w, x, y, z is computed from the diagonal, the others from off-diagonal sums
+        const auto neg_z = m[2][2] < S(0);
+        const auto x_gt_y = m[0][0] > m[1][1];
+        const auto x_lt_neg_y = m[0][0] < -m[1][1];
+        const auto pick = [&](const S &xs, const S &ys, const S &zs, const S &ws) {
+          return trs_select(neg_z, trs_select(x_gt_y, xs, ys), trs_select(x_lt_neg_y, zs, ws));
+        };
+        const S t = pick(S(1) + m[0][0] - m[1][1] - m[2][2], S(1) - m[0][0] + m[1][1] - m[2][2],
+                         S(1) - m[0][0] - m[1][1] + m[2][2], S(1) + m[0][0] + m[1][1] + m[2][2]);
+        const S a01 = m[0][1] + m[1][0], a02 = m[2][0] + m[0][2], a12 = m[1][2] + m[2][1];
+        const S d12 = m[1][2] - m[2][1], d20 = m[2][0] - m[0][2], d01 = m[0][1] - m[1][0];
+        q = {pick(t, a01, a02, d12), pick(a01, t, a12, d20), pick(a02, a12, t, d01), pick(d12, d20, d01, t)};
+
+        const S k = S(0.5) / trs_sqrt(t) * trs_select(q[3] < S(0), S(-1), S(1));
+        for (auto &c : q) {
+          c *= k;
+        }
+      }
+  } // namespace details
+
+  // how Matr4::decompose treats the upper 3x3
+  enum class DecomposeMode {
+    fast,          // rows are assumed orthogonal (no shear)
+    orthogonalize, // rows are orthogonalized first, shear is dropped
+  };
+
+  // R x C matrix stored as R rows (one Row<T, C> register each)
+  // vectors are rows: 'v * m' transforms v, 'a * b' applies a first
+  template <ArithmeticT T, std::size_t R, std::size_t C>
     struct [[nodiscard]] Matr
     {
     public:
       using ValueT = T;
-      using RowT = Row<T, N>;
+      using RowT = Row<T, C>;
+      static constexpr size_t rows = R;
+      static constexpr size_t cols = C;
 
       constexpr Matr() noexcept = default;
 
       template <typename... Args>
         requires (std::is_same_v<Args, RowT> && ...) &&
-                 (sizeof...(Args) == N)
-        constexpr Matr(Args... args) noexcept {
-          _data = std::array<RowT, N>({args...});
-        }
+                 (sizeof...(Args) == R)
+        constexpr Matr(Args... args) noexcept : _data {args...} {}
 
-      constexpr Matr(std::array<RowT, N> rows) : _data(std::move(rows)) {}
+      constexpr Matr(std::array<RowT, R> rows) : _data(std::move(rows)) {}
 
+      // from elements constructor (row-major order)
       template <typename... Args>
         requires (std::is_convertible_v<Args, T> && ...) &&
-                 (sizeof...(Args) == N * N)
+                 (sizeof...(Args) == R * C)
         constexpr Matr(Args... args) noexcept {
-          std::array<T, N * N> tmp {static_cast<T>(args)...};
-          for (size_t i = 0; i < N; i++) {
-            _data[i] = RowT {
-              tmp[N * i + 0],
-              tmp[N * i + 1],
-              tmp[N * i + 2],
-              tmp[N * i + 3]
-            };
-          }
+          const std::array<T, R * C> tmp {static_cast<T>(args)...};
+          mr::details::unroll<R>([&](auto i) {
+            _data[i] = SimdImpl<T, C>([&tmp, i](size_t j) { return tmp[C * i + j]; });
+          });
+        }
+
+      // from memory constructor (reads R * C elements in row-major order)
+      template <typename Flags>
+        constexpr Matr(const T *data, Flags flags) noexcept {
+          mr::details::unroll<R>([&](auto i) { _data[i] = RowT(data + C * i, flags); });
         }
 
       // copy semantics
@@ -64,57 +308,90 @@ namespace mr
       constexpr ~Matr() = default;
 
       // basic math operations
-      constexpr Matr & operator*=(const Matr &other) noexcept {
-        std::array<RowT, N> tmp {};
-        for (size_t i = 0; i < N; i++) {
-          for (size_t j = 0; j < N; j++) {
-            tmp[j] += other._data[i] * _data[j][i];
-          }
-        }
-        *this = tmp;
+      constexpr Matr & operator*=(const Matr &other) noexcept requires (R == C) {
+        *this = *this * other;
         return *this;
       }
 
       constexpr Matr & operator+=(const Matr &other) noexcept {
-        for (int i = 0; i < N; i++) {
-          _data[i] += other._data[i];
-        }
+        mr::details::unroll<R>([&](auto i) { _data[i] += other._data[i]; });
         return *this;
       }
 
       constexpr Matr & operator-=(const Matr &other) noexcept {
-        for (int i = 0; i < N; i++) {
-          _data[i] -= other._data[i];
-        }
+        mr::details::unroll<R>([&](auto i) { _data[i] -= other._data[i]; });
         return *this;
       }
 
-      constexpr Matr operator*(const Matr &other) const noexcept {
-        std::array<RowT, N> tmp{};
-        for (size_t i = 0; i < N; i++) {
-          for (size_t j = 0; j < N; j++) {
-            tmp[j] += other._data[i] * _data[j][i];
-          }
+      // (R x C) * (C x K) -> (R x K)
+      template <std::size_t K>
+        constexpr Matr<T, R, K> operator*(const Matr<T, C, K> &other) const noexcept {
+          Matr<T, R, K> res;
+          mr::details::unroll<R>([&](auto i) {
+            res._data[i] = mr::details::combine_rows(_data[i]._data, other._data);
+          });
+          return res;
         }
-        return {tmp};
-      }
 
       constexpr Matr operator+(const Matr &other) const noexcept {
-        std::array<RowT, N> tmp;
-        for (size_t i = 0; i < N; i++) {
-          tmp[i] = static_cast<RowT>(_data[i] + other._data[i]);
-        }
-        return {tmp};
+        Matr res = *this;
+        res += other;
+        return res;
       }
 
       constexpr Matr operator-(const Matr &other) const noexcept {
-        std::array<RowT, N> tmp;
-        for (size_t i = 0; i < N; i++) {
-          tmp[i] = _data[i] - other._data[i];
+        Matr res = *this;
+        res -= other;
+        return res;
+      }
+
+      // column vector product 'm * v' (see Vec::operator* for 'v * m')
+      constexpr Vec<T, R> operator*(const Vec<T, C> &v) const noexcept requires (R >= 2) {
+        const SimdImpl<T, C> &s = mr::details::row_simd(v);
+        return typename Vec<T, R>::RowT(SimdImpl<T, R>([&](size_t i) { return (_data[i]._data * s).sum(); }));
+      }
+
+      // load/store methods in row-major order (see mr::aligned, mr::unaligned, mr::streaming)
+      [[nodiscard]] static constexpr Matr load(const T *data) noexcept {
+        return Matr(data, unaligned);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Matr load(const T *data, Flags flags) noexcept {
+          return Matr(data, flags);
+        }
+
+      [[nodiscard]] static constexpr Matr load(std::span<const T> data) noexcept {
+        assert(data.size() >= R * C);
+        return Matr(data.data(), unaligned);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Matr load(std::span<const T> data, Flags flags) noexcept {
+          assert(data.size() >= R * C);
+          return Matr(data.data(), flags);
         }
-        return {tmp};
+
+      constexpr void store(T *data) const noexcept {
+        store(data, unaligned);
       }
 
+      template <typename Flags>
+        constexpr void store(T *data, Flags flags) const noexcept {
+          mr::details::unroll<R>([&](auto i) { _data[i].store(data + C * i, flags); });
+        }
+
+      constexpr void store(std::span<T> data) const noexcept {
+        assert(data.size() >= R * C);
+        store(data.data(), unaligned);
+      }
+
+      template <typename Flags>
+        constexpr void store(std::span<T> data, Flags flags) const noexcept {
+          assert(data.size() >= R * C);
+          store(data.data(), flags);
+        }
+
       // matrix related operations
       [[nodiscard]] constexpr const RowT & operator[](size_t i) const noexcept {
         return _data[i];
@@ -124,86 +401,148 @@ namespace mr
         return _data[i];
       }
 
-      // TODO: fix (or remove as it's neved used)
-      [[nodiscard]] constexpr T determinant() const noexcept {
-        std::array<RowT, N> tmp = _data;
-        T det = 1;
-
-        tmp[N - 1] /= tmp[N - 1][N - 1];
-        for (size_t i = 0; i < N - 1; i++) {
-          det *= tmp[i][i];
-          tmp[i] /= mr::equal(tmp[i][i], 0) ? static_cast<T>(1) : tmp[i][i];
-          for (size_t j = i + 1; j < N; j++) {
-            tmp[i + 1] -= tmp[i] * tmp[j][i];
-          }
+      // 4x4: laplace expansion over 2x2 minors of the top and bottom row pairs
+      // (no divisions, exact for small integer valued matrices)
+      [[nodiscard]] constexpr T determinant() const noexcept requires (R == C && R >= 2 && R <= 4) {
+        if constexpr (R == 2) {
+          return _data[0][0] * _data[1][1] - _data[0][1] * _data[1][0];
+        } else if constexpr (R == 3) {
+          return (_data[0]._data * mr::details::cross3_simd(_data[1]._data, _data[2]._data)).sum();
+        } else {
+          return mr::details::determinant_simd(_data[0]._data, _data[1]._data, _data[2]._data, _data[3]._data);
         }
-        return det;
       }
 
-      constexpr Matr transposed() const noexcept {
-        Matr transposed;
-        for (size_t i = 0; i < N; i++) {
-          transposed[i] = SimdImpl<T, N>([this, i](size_t j) { return _data[j][i]; });
+      // determinant of the upper left 3x3 part (negative for transformations which mirror)
+      [[nodiscard]] constexpr T determinant3() const noexcept requires (R == 4 && C == 4) {
+        return (_data[0]._data * mr::details::cross_simd(_data[1]._data, _data[2]._data)).sum();
+      }
+
+      constexpr Matr<T, C, R> transposed() const noexcept {
+        if constexpr (R == 4 && C == 4) {
+          const auto [r0, r1, r2, r3] = mr::details::transpose4_simd(_data[0]._data, _data[1]._data, _data[2]._data, _data[3]._data);
+          return Matr {RowT(r0), RowT(r1), RowT(r2), RowT(r3)};
+        } else {
+          Matr<T, C, R> res;
+          mr::details::unroll<C>([&](auto j) {
+            res[j] = SimdImpl<T, R>([this, j](size_t i) { return _data[i][j]; });
+          });
+          return res;
         }
-        return transposed;
       }
 
-      constexpr Matr & transpose() noexcept {
+      constexpr Matr & transpose() noexcept requires (R == C) {
         *this = transposed();
         return *this;
       }
 
-// TODO: implement this using Vc library
-#if 0
-      constexpr Matr inversed() const noexcept {
-        constexpr auto io = std::ranges::iota_view{(size_t)0, N};
+      // 2x2 and 3x3 inverses (adjugate divided by determinant, matrix must be invertible)
+      constexpr Matr inversed() const noexcept requires (R == C && R <= 3 && std::floating_point<T>) {
+        const T inv_det = T(1) / determinant();
+        if constexpr (R == 2) {
+          return Matr {
+             _data[1][1] * inv_det, -_data[0][1] * inv_det,
+            -_data[1][0] * inv_det,  _data[0][0] * inv_det
+          };
+        } else {
+          // columns of the inverse are cross products of the rows
+          const Matr cols {
+            RowT(mr::details::cross3_simd(_data[1]._data, _data[2]._data) * inv_det),
+            RowT(mr::details::cross3_simd(_data[2]._data, _data[0]._data) * inv_det),
+            RowT(mr::details::cross3_simd(_data[0]._data, _data[1]._data) * inv_det)
+          };
+          return cols.transposed();
+        }
+      }
 
-        std::array<Row<T, 2 * N>, N> tmp;
-        std::for_each(io.begin(), io.end(),
-                      [&tmp, this](auto i) {
-                        // adding temporary variable here brings performance down 2.5 times (reason unknown)
-                        tmp[i] += stdx::simd_cast<SimdImpl<T, 2 * N>>(stdx::concat(_data[i]._data, identity[i]._data));
-                      });
+      // 4x4 general inverse (cofactors of 2x2 blocks, no branches)
+      // matrix must be invertible, singular input gives non-finite elements
+      constexpr Matr inversed() const noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        using mr::details::shuffle_simd;
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT &r0 = _data[0]._data, &r1 = _data[1]._data, &r2 = _data[2]._data, &r3 = _data[3]._data;
+
+        // 2x2 blocks stored as (m00, m01, m10, m11)
+        const SimdT a = shuffle_simd<0, 1, 4, 5>(r0, r1);
+        const SimdT b = shuffle_simd<2, 3, 6, 7>(r0, r1);
+        const SimdT c = shuffle_simd<0, 1, 4, 5>(r2, r3);
+        const SimdT d = shuffle_simd<2, 3, 6, 7>(r2, r3);
+
+        // (det(a), det(b), det(c), det(d))
+        const SimdT det_sub =
+          shuffle_simd<0, 2, 4, 6>(r0, r2) * shuffle_simd<1, 3, 5, 7>(r1, r3) -
+          shuffle_simd<1, 3, 5, 7>(r0, r2) * shuffle_simd<0, 2, 4, 6>(r1, r3);
+        const T det_a = det_sub[0], det_b = det_sub[1], det_c = det_sub[2], det_d = det_sub[3];
+
+        const SimdT d_c = mr::details::mat2_adj_mul(d, c);
+        const SimdT a_b = mr::details::mat2_adj_mul(a, b);
+
+        const SimdT x = det_d * a - mr::details::mat2_mul(b, d_c);
+        const SimdT w = det_a * d - mr::details::mat2_mul(c, a_b);
+        const SimdT y = det_b * c - mr::details::mat2_mul_adj(d, a_b);
+        const SimdT z = det_c * b - mr::details::mat2_mul_adj(a, d_c);
+
+        const T det = det_a * det_d + det_b * det_c - (a_b * shuffle_simd<0, 2, 1, 3>(d_c, d_c)).sum();
+        const SimdT inv_det = SimdT([](size_t i) { return i == 0 || i == 3 ? T(1) : T(-1); }) / det;
+
+        const SimdT xs = x * inv_det, ys = y * inv_det, zs = z * inv_det, ws = w * inv_det;
+        return Matr {
+          RowT(shuffle_simd<3, 1, 7, 5>(xs, ys)),
+          RowT(shuffle_simd<2, 0, 6, 4>(xs, ys)),
+          RowT(shuffle_simd<3, 1, 7, 5>(zs, ws)),
+          RowT(shuffle_simd<2, 0, 6, 4>(zs, ws))
+        };
+      }
 
-        // null bottom triangle
-        for (size_t i = 1; i < N; i++) {
-          tmp[i - 1] /= tmp[i - 1][i - 1];
-          for (size_t j = i; j < N; j++) {
-            tmp[j] -= std::abs(tmp[i - 1][i - 1]) <= _epsilon ? static_cast<T>(0) : tmp[i - 1] * tmp[j][i - 1];
-          }
-        }
-        tmp[N - 1] /= tmp[N - 1][N - 1];
+      // inverse of an affine transformation (last column must be (0, 0, 0, 1))
+      // 3x3 part is inverted with cross products
+      constexpr Matr inversed_affine() const noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT &r0 = _data[0]._data, &r1 = _data[1]._data, &r2 = _data[2]._data;
 
-        // null top triangle
-        for (int i = N - 2; i >= 0; i--) {
-          for (int j = i; j >= 0; j--) {
-            tmp[j] -= std::abs(tmp[i + 1][i + 1]) <= _epsilon ? static_cast<T>(0) : tmp[i + 1] * tmp[j][i + 1];
-          }
-        }
+        // columns of the inverse (scaled by det)
+        const SimdT c0 = mr::details::cross_simd(r1, r2);
+        const SimdT c1 = mr::details::cross_simd(r2, r0);
+        const SimdT c2 = mr::details::cross_simd(r0, r1);
+        const T inv_det = T(1) / (r0 * c0).sum();
 
-        std::array<RowT, N> res;
-        std::for_each(io.begin(), io.end(),
-          [&tmp, &res](auto i) {
-            auto [a, b] = stdx::split<N, N>(tmp[i]._data);
-            res[i] = stdx::simd_cast<SimdImpl<T, N>>(b);
-          });
+        return _affine_from_columns(c0 * inv_det, c1 * inv_det, c2 * inv_det);
+      }
 
-        return res;
+      // inverse of a rotation + translation (3x3 part must be orthonormal)
+      // 3x3 part is transposed
+      constexpr Matr inversed_rigid() const noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        return _affine_from_columns(_data[0]._data, _data[1]._data, _data[2]._data);
       }
-#else
-      // dummy
-      constexpr Matr inversed() const noexcept {
-        return {};
+
+      // inverse transpose of the upper 3x3, transforms normals ('n * m.normal_matrix()')
+      [[nodiscard]] constexpr Matr3<T> normal_matrix() const noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        using mr::details::shuffle_simd;
+        const auto [n0, n1, n2] = mr::details::normal_rows_simd(_data[0]._data, _data[1]._data, _data[2]._data);
+        return Matr3<T> {
+          Row<T, 3>(shuffle_simd<0, 1, 2>(n0, n0)),
+          Row<T, 3>(shuffle_simd<0, 1, 2>(n1, n1)),
+          Row<T, 3>(shuffle_simd<0, 1, 2>(n2, n2))
+        };
       }
-#endif
 
-      constexpr Matr & inverse() noexcept {
+      constexpr Matr & inverse() noexcept requires (R == C && R <= 4 && std::floating_point<T>) {
         *this = inversed();
         return *this;
       }
 
-      static constexpr Matr identity() noexcept {
-        return _identity;
+      constexpr Matr & inverse_affine() noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        *this = inversed_affine();
+        return *this;
+      }
+
+      constexpr Matr & inverse_rigid() noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        *this = inversed_rigid();
+        return *this;
+      }
+
+      static constexpr Matr identity() noexcept requires (R == C) {
+        return Matr(_identity_table.data(), unaligned);
       }
 
       static constexpr Matr4<T> scale(const Vec3<T> &vec) noexcept {
@@ -288,30 +627,51 @@ namespace mr
         };
       }
 
+      // rotation around unit axis n, rows are written once from a single sincos
       static constexpr Matr4<T> rotate(const Norm<T, 3> &n, const Radians<T> &rad) noexcept {
-        T co = std::cos(rad._data);
-        T si = std::sin(rad._data);
-        T nco = 1 - co;
-
-        Matr4<T> tmp1 = scale(n * n * nco + Vec<T, 3>{co});
-        Matr4<T> tmp2 = Matr4<T> {
-                            0, n.x() * n.y() * nco, n.x() * n.z() * nco, 0,
-          n.x() * n.y() * nco,                   0, n.y() * n.z() * nco, 0,
-          n.x() * n.z() * nco, n.y() * n.z() * nco,                   0, 0,
-                            0,                   0,                   0, 0
+        T si, co;
+        mr::details::sincos(rad._data, si, co);
+        const auto m = mr::details::rotate_kernel<T>({n.x(), n.y(), n.z()}, si, co);
+        return Matr4<T> {
+          RowT(m[0][0], m[0][1], m[0][2], 0),
+          RowT(m[1][0], m[1][1], m[1][2], 0),
+          RowT(m[2][0], m[2][1], m[2][2], 0),
+          RowT(0, 0, 0, 1)
         };
-        Matr4<T> tmp3 = Matr4<T> {
-                    0, -n.z() * si,  n.y() * si, 0,
-           n.z() * si,           0, -n.x() * si, 0,
-          -n.y() * si,  n.x() * si,           0, 0,
-                    0,           0,           0, 0
+      }
+
+      // scale(s) * rotation(q) * translate(t) in one pass (q must be normalized)
+      static constexpr Matr4<T> trs(const Vec3<T> &t, const Quat<T> &q, const Vec3<T> &s = Vec3<T>(1, 1, 1)) noexcept
+          requires (R == 4 && C == 4 && std::floating_point<T>) {
+        const auto m = mr::details::trs_compose_kernel<T>({q.x(), q.y(), q.z(), q.w()}, {s.x(), s.y(), s.z()});
+        return Matr4<T> {
+          RowT(m[0][0], m[0][1], m[0][2], 0),
+          RowT(m[1][0], m[1][1], m[1][2], 0),
+          RowT(m[2][0], m[2][1], m[2][2], 0),
+          RowT(t.x(), t.y(), t.z(), 1)
         };
+      }
 
-        return tmp1 + tmp2 + tmp3;
+      static constexpr Matr4<T> trs(const Trs<T> &trs) noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+        return Matr4<T>::trs(trs.translation, trs.rotation, trs.scale);
       }
 
+      // inverse of trs() for matrices with (0, 0, 0, 1) last column
+      // mirrored matrices get negative x scale, rotation has non-negative w
+      template <DecomposeMode Mode = DecomposeMode::fast>
+        [[nodiscard]] constexpr Trs<T> decompose() const noexcept requires (R == 4 && C == 4 && std::floating_point<T>) {
+          std::array<T, 4> q;
+          std::array<T, 3> s;
+          mr::details::trs_decompose_kernel<T>({{
+            {_data[0][0], _data[0][1], _data[0][2]},
+            {_data[1][0], _data[1][1], _data[1][2]},
+            {_data[2][0], _data[2][1], _data[2][2]},
+          }}, Mode == DecomposeMode::orthogonalize, q, s);
+          return {Vec3<T>(_data[3][0], _data[3][1], _data[3][2]), Quat<T>(Radians<T>(q[3]), q[0], q[1], q[2]), Vec3<T>(s[0], s[1], s[2])};
+        }
+
       constexpr bool operator==(const Matr &other) const noexcept {
-        for (size_t i = 0; i < N; i++) {
+        for (size_t i = 0; i < R; i++) {
           if (_data[i] != other._data[i]) {
             return false;
           }
@@ -320,7 +680,7 @@ namespace mr
       }
 
       constexpr bool equal(const Matr &other, ValueT eps = epsilon<ValueT>()) const noexcept {
-        for (size_t i = 0; i < N; i++) {
+        for (size_t i = 0; i < R; i++) {
           if (not _data[i].equal(other._data[i], eps)) {
             return false;
           }
@@ -330,45 +690,52 @@ namespace mr
 
       friend std::ostream & operator<<(std::ostream &os, const Matr &m) noexcept {
         os << "\n(" << m[0] << ",\n";
-          for (size_t i = 1; i < N - 1; i++)
+          for (size_t i = 1; i < R - 1; i++)
             os << ' ' << m[i] << ",\n";
-          os << ' ' << m[N - 1] << ')';
+          os << ' ' << m[R - 1] << ')';
         return os;
       }
 
     private:
-      static Matr get_identity() {
-        std::array<RowT, N> id;
-        constexpr auto io = std::ranges::iota_view {(size_t)0, N};
-
-        std::transform(
-          io.begin(), io.end(), id.begin(),
-          [&io](size_t i) -> RowT {
-            return SimdImpl<T, N>([i](size_t j) { return j == i ? 1 : 0; });
-          });
-
-        return id;
+      // affine matrix with 3x3 part made of columns c0, c1, c2 (their w must be 0)
+      // and translation of this matrix transformed by it (negated)
+      constexpr Matr _affine_from_columns(const SimdImpl<T, 4> &c0, const SimdImpl<T, 4> &c1, const SimdImpl<T, 4> &c2) const noexcept {
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT &t = _data[3]._data;
+
+        const auto [i0, i1, i2] = mr::details::transpose3_simd(c0, c1, c2);
+        const SimdT it = SimdT([](size_t i) { return i == 3 ? T(1) : T(0); }) - (t[0] * i0 + t[1] * i1 + t[2] * i2);
+        return Matr {RowT(i0), RowT(i1), RowT(i2), RowT(it)};
       }
 
     public:
-      std::array<RowT, N> _data;
+      std::array<RowT, R> _data;
 
     private:
-      static const Matr _identity;
-      inline static const T _epsilon = std::numeric_limits<T>::epsilon();
+      // row-major identity elements (compile time constant, no static initialization)
+      static constexpr std::array<T, R * C> _identity_table = [] {
+        std::array<T, R * C> res {};
+        for (size_t i = 0; i < std::min(R, C); i++) {
+          res[i * C + i] = 1;
+        }
+        return res;
+      }();
+      static constexpr T _epsilon = std::numeric_limits<T>::epsilon();
     };
 
-    // this is required to initialize 'Matr::_identity' on MSVC 
-    template <ArithmeticT T, std::size_t N>
-      const Matr<T, N> Matr<T, N>::_identity = Matr<T, N>::get_identity();
+    // row vector times rectangular matrix (square matrices are handled by Vec::operator*)
+    template <ArithmeticT T, std::size_t R, std::size_t C> requires (R != C && C >= 2)
+      constexpr Vec<T, C> operator*(const Vec<T, R> &v, const Matr<T, R, C> &m) noexcept {
+        return typename Vec<T, C>::RowT(mr::details::combine_rows(mr::details::row_simd(v), m._data));
+      }
 
 } // namespace mr
 
 #ifdef __cpp_lib_format
 // std::format support
 namespace std {
-  template <mr::ArithmeticT T, size_t N>
-    struct formatter<mr::Matr<T, N>> {
+  template <mr::ArithmeticT T, size_t R, size_t C>
+    struct formatter<mr::Matr<T, R, C>> {
       template<typename ParseContext>
         constexpr auto parse(ParseContext& ctx) {
           // skip all format specifiers
@@ -379,7 +746,7 @@ namespace std {
         }
 
       template<typename FmtContext>
-        auto format(const mr::Matr<T, N> &m, FmtContext& ctx) const {
+        auto format(const mr::Matr<T, R, C> &m, FmtContext& ctx) const {
           ostringstream out;
           out << m;
           return ranges::copy(std::move(out).str(), ctx.out()).out;
@@ -99,9 +99,9 @@ namespace mr {
       template<ArithmeticT R>
         constexpr VecT operator*(const Matr<R, N> &other) const noexcept {
           VecT tmp {};
-          for (size_t i = 0; i < N; i++) {
-            tmp._data += (other._data[i] * _data[i])._data;
-          }
+          [&]<std::size_t ...I>(std::index_sequence<I...>) {
+            ((tmp._data += (other._data[I] * _data[I])._data), ...);
+          }(std::make_index_sequence<N>{});
           return tmp;
         }
 
@@ -110,9 +110,9 @@ namespace mr {
           Vec<T, N + 1> copy = Vec<T, N + 1>(*this);
           Vec<T, N + 1> tmp {};
 
-          for (size_t i = 0; i < N; i++) {
-            tmp._data += (other._data[i] * copy._data[i])._data;
-          }
+          [&]<std::size_t ...I>(std::index_sequence<I...>) {
+            ((tmp._data += (other._data[I] * copy._data[I])._data), ...);
+          }(std::make_index_sequence<N>{});
           tmp._data += other._data[N]._data;
           return {tmp};
         }
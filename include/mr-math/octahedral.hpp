@@ -0,0 +1,227 @@
+#ifndef __MR_OCTAHEDRAL_HPP_
+#define __MR_OCTAHEDRAL_HPP_
+
+#include "def.hpp"
+#include "vec.hpp"
+#include "norm.hpp"
+#include "rsqrt.hpp"
+
+// octahedral encoding of unit vectors
+// the sphere is projected onto an octahedron which is unfolded into a square,
+// both square coordinates are quantized to Bits / 2 bits:
+//   mr::OctNorm16 packed = mr::oct_encode<16>(n);    // 2 bytes instead of a full register
+//   mr::Norm3f n2 = mr::oct_decode(packed);
+// maximum angular error: ~0.95 degrees (16 bits), ~0.06 degrees (24 bits), ~0.004 degrees (32 bits)
+
+namespace mr {
+  // forward declarations
+  template <std::size_t Bits> requires (Bits == 16 || Bits == 24 || Bits == 32)
+    struct OctNorm;
+
+  // common aliases
+  using OctNorm16 = OctNorm<16>;
+  using OctNorm24 = OctNorm<24>;
+  using OctNorm32 = OctNorm<32>;
+
+  // encoded Norm3 (use oct_encode/oct_decode)
+  template <std::size_t Bits> requires (Bits == 16 || Bits == 24 || Bits == 32)
+    struct [[nodiscard]] OctNorm {
+    public:
+      static constexpr std::size_t axis_bits = Bits / 2;
+      static constexpr uint32_t axis_max = (1u << axis_bits) - 1;
+      // coordinate c in [-1, 1] is stored as round(c * scale) + scale, so 0 and +-1 are exact
+      static constexpr uint32_t axis_scale = (1u << (axis_bits - 1)) - 1;
+
+      // 24 bit version is stored in 3 bytes
+      using StorageT = std::conditional_t<Bits == 16, uint16_t,
+        std::conditional_t<Bits == 24, std::array<uint8_t, 3>, uint32_t>>;
+
+      StorageT _data {};
+
+      constexpr OctNorm() noexcept = default;
+
+      // from quantized square coordinates
+      constexpr OctNorm(uint32_t u, uint32_t v) noexcept {
+        assert(u <= axis_max && v <= axis_max);
+        const uint32_t bits = u | (v << axis_bits);
+        if constexpr (Bits == 24) {
+          _data = {uint8_t(bits), uint8_t(bits >> 8), uint8_t(bits >> 16)};
+        } else {
+          _data = static_cast<StorageT>(bits);
+        }
+      }
+
+      [[nodiscard]] constexpr uint32_t bits() const noexcept {
+        if constexpr (Bits == 24) {
+          return uint32_t(_data[0]) | (uint32_t(_data[1]) << 8) | (uint32_t(_data[2]) << 16);
+        } else {
+          return _data;
+        }
+      }
+
+      [[nodiscard]] constexpr uint32_t u() const noexcept { return bits() & axis_max; }
+      [[nodiscard]] constexpr uint32_t v() const noexcept { return bits() >> axis_bits; }
+
+      constexpr bool operator==(const OctNorm &other) const noexcept = default;
+    };
+
+  static_assert(sizeof(OctNorm16) == 2);
+  static_assert(sizeof(OctNorm24) == 3);
+  static_assert(sizeof(OctNorm32) == 4);
+
+  namespace details {
+    // works for scalars and registers
+    template <typename S>
+      constexpr S oct_abs(const S &x) noexcept {
+        if constexpr (ArithmeticT<S>) {
+          return std::abs(x);
+        } else {
+          return stdx::abs(x);
+        }
+      }
+
+    // sign with +1 for 0 (keeps folded points on the right side of the square)
+    template <typename S>
+      constexpr S oct_sign(const S &x) noexcept {
+        if constexpr (ArithmeticT<S>) {
+          return x >= 0 ? S(1) : S(-1);
+        } else {
+          return stdx::iif(x >= S(0), S(1), S(-1));
+        }
+      }
+
+    // cond < 0 ? a : b
+    template <typename S>
+      constexpr S oct_select(const S &cond, const S &a, const S &b) noexcept {
+        if constexpr (ArithmeticT<S>) {
+          return cond < 0 ? a : b;
+        } else {
+          return stdx::iif(cond < S(0), a, b);
+        }
+      }
+
+    // unit vector -> quantized square coordinates (in [0, 2 * scale])
+    template <typename S>
+      constexpr void oct_encode_kernel(const S &x, const S &y, const S &z, S scale, S &u, S &v) noexcept {
+        const S inv_l1 = S(1) / (oct_abs(x) + oct_abs(y) + oct_abs(z));
+        S px = x * inv_l1;
+        S py = y * inv_l1;
+        // lower hemisphere is folded over the diagonals
+        const S fx = (S(1) - oct_abs(py)) * oct_sign(px);
+        const S fy = (S(1) - oct_abs(px)) * oct_sign(py);
+        px = oct_select(z, fx, px);
+        py = oct_select(z, fy, py);
+
+        if constexpr (ArithmeticT<S>) {
+          u = std::floor(px * scale + scale + S(0.5));
+          v = std::floor(py * scale + scale + S(0.5));
+        } else {
+          u = stdx::floor(px * scale + scale + S(0.5));
+          v = stdx::floor(py * scale + scale + S(0.5));
+        }
+      }
+
+    // quantized square coordinates -> unnormalized vector
+    template <typename S>
+      constexpr void oct_decode_kernel(const S &u, const S &v, S inv_scale, S &x, S &y, S &z) noexcept {
+        x = u * inv_scale - S(1);
+        y = v * inv_scale - S(1);
+        z = S(1) - oct_abs(x) - oct_abs(y);
+        const S fx = (S(1) - oct_abs(y)) * oct_sign(x);
+        const S fy = (S(1) - oct_abs(x)) * oct_sign(y);
+        x = oct_select(z, fx, x);
+        y = oct_select(z, fy, y);
+      }
+  } // namespace details
+
+  template <std::size_t Bits, std::floating_point T>
+    constexpr OctNorm<Bits> oct_encode(const Norm3<T> &n) noexcept {
+      T u, v;
+      mr::details::oct_encode_kernel<T>(n.x(), n.y(), n.z(), T(OctNorm<Bits>::axis_scale), u, v);
+      return {static_cast<uint32_t>(u), static_cast<uint32_t>(v)};
+    }
+
+  // decoded vector is normalized once (newton refined rsqrt is far below quantization error)
+  // and passed through the unchecked Norm3 constructor
+  template <std::floating_point T = float, std::size_t Bits>
+    constexpr Norm3<T> oct_decode(const OctNorm<Bits> &o) noexcept {
+      T x, y, z;
+      mr::details::oct_decode_kernel<T>(T(o.u()), T(o.v()), T(1) / OctNorm<Bits>::axis_scale, x, y, z);
+      const T inv_len = rsqrt<RsqrtPrecision::newton2>(x * x + y * y + z * z);
+      return {unchecked, Vec3<T>(x * inv_len, y * inv_len, z * inv_len)};
+    }
+
+  namespace details {
+    template <typename T>
+      inline constexpr bool is_oct_norm = false;
+    template <std::size_t Bits>
+      inline constexpr bool is_oct_norm<OctNorm<Bits>> = true;
+
+    template <typename R>
+      concept Norm3RangeT = std::ranges::contiguous_range<R> &&
+        std::same_as<std::ranges::range_value_t<R>, Norm3<typename std::ranges::range_value_t<R>::ValueT>>;
+
+    template <typename R>
+      concept OctNormRangeT = std::ranges::contiguous_range<R> && is_oct_norm<std::ranges::range_value_t<R>>;
+  } // namespace details
+
+  // batch versions (native registers, NativeSimdImpl<T>::size() normals per iteration)
+  template <mr::details::Norm3RangeT I, mr::details::OctNormRangeT O>
+    void oct_encode(const I &in, O &&out) noexcept {
+      using T = typename std::ranges::range_value_t<I>::ValueT;
+      using E = std::ranges::range_value_t<O>;
+      using SimdT = NativeSimdImpl<T>;
+      constexpr size_t width = SimdT::size();
+      const size_t n = std::ranges::size(out);
+      assert(std::ranges::size(in) >= n);
+      const auto *src = std::ranges::data(in);
+      auto *dst = std::ranges::data(out);
+
+      size_t i = 0;
+      for (; i + width <= n; i += width) {
+        const SimdT x = SimdT::generate([src, i](size_t l) { return src[i + l].x(); });
+        const SimdT y = SimdT::generate([src, i](size_t l) { return src[i + l].y(); });
+        const SimdT z = SimdT::generate([src, i](size_t l) { return src[i + l].z(); });
+        SimdT u, v;
+        mr::details::oct_encode_kernel(x, y, z, SimdT(T(E::axis_scale)), u, v);
+        for (size_t l = 0; l < width; l++) {
+          dst[i + l] = E(static_cast<uint32_t>(u[l]), static_cast<uint32_t>(v[l]));
+        }
+      }
+      for (; i < n; i++) {
+        dst[i] = oct_encode<E::axis_bits * 2>(src[i]);
+      }
+    }
+
+  template <mr::details::OctNormRangeT I, mr::details::Norm3RangeT O>
+    void oct_decode(const I &in, O &&out) noexcept {
+      using T = typename std::ranges::range_value_t<O>::ValueT;
+      using E = std::ranges::range_value_t<I>;
+      using SimdT = NativeSimdImpl<T>;
+      constexpr size_t width = SimdT::size();
+      const size_t n = std::ranges::size(out);
+      assert(std::ranges::size(in) >= n);
+      const auto *src = std::ranges::data(in);
+      auto *dst = std::ranges::data(out);
+
+      size_t i = 0;
+      for (; i + width <= n; i += width) {
+        const SimdT u = SimdT::generate([src, i](size_t l) { return T(src[i + l].u()); });
+        const SimdT v = SimdT::generate([src, i](size_t l) { return T(src[i + l].v()); });
+        SimdT x, y, z;
+        mr::details::oct_decode_kernel(u, v, SimdT(T(1) / E::axis_scale), x, y, z);
+        const SimdT inv_len = rsqrt<RsqrtPrecision::newton2>(x * x + y * y + z * z);
+        x *= inv_len;
+        y *= inv_len;
+        z *= inv_len;
+        for (size_t l = 0; l < width; l++) {
+          dst[i + l] = Norm3<T>(unchecked, Vec3<T>(x[l], y[l], z[l]));
+        }
+      }
+      for (; i < n; i++) {
+        dst[i] = oct_decode<T>(src[i]);
+      }
+    }
+} // namespace mr
+
+#endif // __MR_OCTAHEDRAL_HPP_
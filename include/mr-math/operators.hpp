@@ -28,7 +28,7 @@ namespace mr {
         return lhs;
       }
 
-      friend constexpr DerivedT &
+      friend constexpr DerivedT
       operator+(const DerivedT &lhs, const ArithmeticT auto rhs) noexcept {
         return DerivedT{lhs._data + rhs};
       }
@@ -7,56 +7,109 @@
 #include "matr.hpp"
 #include "rot.hpp"
 
+// quaternion stored in a single register as (x, y, z, w), w is the scalar part
+//   mr::Quatf q = a * b;                     // Hamilton product (shuffles and multiply-adds)
+//   mr::Vec3f p = q.rotate(v);               // q must be normalized
+//   mr::Quatf back = q.inversed();           // q.conjugated() for normalized quaternions
+// constructors and Vec4 conversion keep the (w, x, y, z) element order
+
 namespace mr {
-  template <ArithmeticT T>
-    struct Quat {
-    private:
-      Radians<T> _angle {};
-      Vec3<T> _vec {};
+  // common aliases
+  using Quatf = Quat<float>;
+  using Quatd = Quat<double>;
+
+  namespace details {
+    // Hamilton product of (x, y, z, w) registers
+    template <typename T>
+      constexpr SimdImpl<T, 4> quat_mul_simd(const SimdImpl<T, 4> &a, const SimdImpl<T, 4> &b) noexcept {
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT sign([](size_t i) { return i < 3 ? T(1) : T(-1); });
+        return shuffle_simd<3, 3, 3, 3>(a, a) * b +
+               (shuffle_simd<0, 1, 2, 0>(a, a) * shuffle_simd<3, 3, 3, 0>(b, b) +
+                shuffle_simd<1, 2, 0, 1>(a, a) * shuffle_simd<2, 0, 1, 1>(b, b)) * sign -
+               shuffle_simd<2, 0, 1, 2>(a, a) * shuffle_simd<1, 2, 0, 2>(b, b);
+      }
+  } // namespace details
 
+  template <ArithmeticT T>
+    struct [[nodiscard]] Quat {
     public:
+      using ValueT = T;
+      using RowT = Row<T, 4>;
+      using SimdT = SimdImpl<T, 4>;
+
+      RowT _data {};
+
       constexpr Quat() noexcept = default;
-      constexpr Quat(Vec4<T> v) noexcept : _angle(v.x()), _vec(v.y(), v.z(), v.w()) {}
-      constexpr Quat(Radians<T> a, Vec3<T> v) noexcept : _angle(a), _vec(v) {}
-      constexpr Quat(Radians<T> a, T x, T y, T z) noexcept : _angle(a), _vec(x, y, z) {}
+      constexpr Quat(Vec4<T> v) noexcept : _data(mr::details::shuffle_simd<1, 2, 3, 0>(v._data._data, v._data._data)) {}
+      constexpr Quat(Radians<T> a, Vec3<T> v) noexcept : _data(v.x(), v.y(), v.z(), a._data) {}
+      constexpr Quat(Radians<T> a, T x, T y, T z) noexcept : _data(x, y, z, a._data) {}
 
       // getters
-      [[nodiscard]] constexpr Vec3<T> vec() const noexcept { return _vec; }
-      [[nodiscard]] constexpr T x() const noexcept { return _vec.x(); }
-      [[nodiscard]] constexpr T y() const noexcept { return _vec.y(); }
-      [[nodiscard]] constexpr T z() const noexcept { return _vec.z(); }
-      [[nodiscard]] constexpr T w() const noexcept { return _angle._data; }
+      [[nodiscard]] constexpr Vec3<T> vec() const noexcept { return {x(), y(), z()}; }
+      [[nodiscard]] constexpr T x() const noexcept { return _data[0]; }
+      [[nodiscard]] constexpr T y() const noexcept { return _data[1]; }
+      [[nodiscard]] constexpr T z() const noexcept { return _data[2]; }
+      [[nodiscard]] constexpr T w() const noexcept { return _data[3]; }
 
       explicit constexpr operator Vec4<T>() const noexcept {
-        return Vec4<T>{_angle._data, _vec.x(), _vec.y(), _vec.z()};
+        return RowT(mr::details::shuffle_simd<3, 0, 1, 2>(_data._data, _data._data));
+      }
+
+      [[nodiscard]] constexpr T length2() const noexcept {
+        return (_data._data * _data._data).sum();
       }
 
       // normalize methods
       constexpr Quat & normalize() noexcept {
-        auto len = _vec.length2() + w() * w();
+        auto len = length2();
         if (len <= mr::Vec3<T>::_epsilon) [[unlikely]] return *this;
-        _vec /= std::sqrt(len);
-        _angle /= std::sqrt(len);
+        _data._data /= std::sqrt(len);
         return *this;
-      };
+      }
 
       constexpr std::optional<Quat> normalized() const noexcept {
-        auto len = _vec.length2() + w() * w();
+        auto len = length2();
         if (len <= mr::Vec3<T>::_epsilon) [[unlikely]] return std::nullopt;
-        auto res = *this;
-        res._vec /= sqrt(len);
-        res._angle /= sqrt(len);
-        return res;
-      };
+        return Quat(_data._data / std::sqrt(len));
+      }
+
+      // (-x, -y, -z, w), inverse rotation of a normalized quaternion
+      constexpr Quat & conjugate() noexcept {
+        *this = conjugated();
+        return *this;
+      }
+
+      constexpr Quat conjugated() const noexcept {
+        return Quat(_data._data * SimdT([](size_t i) { return i < 3 ? T(-1) : T(1); }));
+      }
+
+      // multiplicative inverse (must be non-zero)
+      constexpr Quat & inverse() noexcept {
+        *this = inversed();
+        return *this;
+      }
+
+      constexpr Quat inversed() const noexcept {
+        return Quat(conjugated()._data._data / length2());
+      }
+
+      // q * (v, 0) * q^-1 as v + w * t + q.vec() x t, t = 2 * q.vec() x v (q must be normalized)
+      [[nodiscard]] constexpr Vec3<T> rotate(const Vec3<T> &v) const noexcept {
+        const SimdT p = mr::details::row_simd(Vec4<T>(v.x(), v.y(), v.z(), 0));
+        const SimdT t = mr::details::cross_simd(_data._data, p) * T(2);
+        const SimdT res = p + w() * t + mr::details::cross_simd(_data._data, t);
+        return {res[0], res[1], res[2]};
+      }
 
       friend constexpr Quat
       operator+(const Quat &lhs, const Quat &rhs) noexcept {
-        return Quat{mr::Radiansf(lhs.w() + rhs.w()), lhs.vec() + rhs.vec()};
+        return Quat(lhs._data._data + rhs._data._data);
       }
 
       friend constexpr Quat
       operator-(const Quat &lhs, const Quat &rhs) noexcept {
-        return Quat{mr::Radiansf(lhs.w() - rhs.w()), lhs.vec() - rhs.vec()};
+        return Quat(lhs._data._data - rhs._data._data);
       }
 
       friend constexpr Quat &
@@ -72,28 +125,41 @@ namespace mr {
       }
 
       friend constexpr Quat operator*(const Quat &lhs, const Quat &rhs) noexcept {
-        return {
-          mr::Radiansf(lhs.w() * rhs.w() - lhs.vec().dot(rhs.vec())),
-          lhs.w() * rhs.vec() + rhs.w() * lhs.vec() + lhs.vec() % rhs.vec()
-        };
+        return Quat(mr::details::quat_mul_simd(lhs._data._data, rhs._data._data));
       }
       friend constexpr Quat & operator*=(Quat &lhs, const Quat &rhs) noexcept {
         lhs = lhs * rhs;
         return lhs;
       }
 
+      // rhs is (angle, unit axis) here
         friend constexpr Vec<T, 3> operator*(const Vec<T, 3> &lhs, const Quat &rhs) noexcept {
-          auto vq = rhs.vec() * std::cos(rhs.w() / 2);
-          auto t = vq % lhs;
-          auto u = std::sin(rhs.w() / 2) * t + vq % t;
-
-          return {lhs + u + u};
+          T s, c;
+          mr::details::sincos(rhs.w() / 2, s, c);
+          return Quat(SimdT([&rhs, s, c](size_t i) { return i < 3 ? rhs._data[i] * s : c; })).rotate(lhs);
         }
       template <std::size_t N>
         friend constexpr Vec<T, N> & operator*=(Vec<T, N> &lhs, const Quat &rhs) noexcept {
           lhs = lhs * rhs;
           return lhs;
         }
+
+      constexpr bool operator==(const Quat &other) const noexcept {
+        return _data == other._data;
+      }
+
+      constexpr bool equal(const Quat &other, ValueT eps = epsilon<ValueT>()) const noexcept {
+        return _data.equal(other._data, eps);
+      }
+
+      friend std::ostream & operator<<(std::ostream &os, const Quat &q) noexcept {
+        os << '(' << q.w() << ", " << q.x() << ", " << q.y() << ", " << q.z() << ')';
+        return os;
+      }
+
+    private:
+      // from (x, y, z, w) register
+      constexpr explicit Quat(const SimdT &data) noexcept : _data(data) {}
     };
 }
 
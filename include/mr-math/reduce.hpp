@@ -0,0 +1,204 @@
+#ifndef __MR_REDUCE_HPP_
+#define __MR_REDUCE_HPP_
+
+#include "def.hpp"
+#include "row.hpp"
+#include "vec.hpp"
+#include "bound_box.hpp"
+
+// reductions over contiguous ranges of Row/Vec (component_min/max, sum, mean, bounds, min/max_length)
+// usage:
+//   mr::AABBf box = mr::bounds(points);
+//   mr::Vec3f center = mr::mean(points, mr::parallel); // split across threads for large inputs
+// accumulation is done in registers with several independent accumulators
+// mr::parallel starts its threads on every call (no pool), so only inputs large enough to
+// amortize thread creation are split
+
+namespace mr {
+  inline constexpr struct ParallelTag {} parallel {};
+
+  namespace details {
+    template <typename R>
+      concept RowRangeT = std::ranges::contiguous_range<R> && RowLikeT<std::ranges::range_value_t<R>>;
+
+    // inputs smaller than this are never split across threads
+    inline constexpr std::size_t parallel_reduce_chunk = 1 << 14;
+
+    // op(...op(op(init, map(in[0])), map(in[1]))..., map(in[n - 1]))
+    // 4 accumulators hide the latency of dependent 'op' chains
+    template <typename E, typename A, typename Map, typename Op>
+      A reduce(std::span<const E> in, const A &init, Map &&map, Op &&op) noexcept {
+        A acc0 = init, acc1 = init, acc2 = init, acc3 = init;
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+          acc0 = op(acc0, map(in[i + 0]));
+          acc1 = op(acc1, map(in[i + 1]));
+          acc2 = op(acc2, map(in[i + 2]));
+          acc3 = op(acc3, map(in[i + 3]));
+        }
+        for (; i < in.size(); i++) {
+          acc0 = op(acc0, map(in[i]));
+        }
+        return op(op(acc0, acc1), op(acc2, acc3));
+      }
+
+    // calls f(t) for t in [0, count): t == 0 on the calling thread, the others on threads started
+    // here and joined before return; if no more threads can be started (std::system_error),
+    // the remaining calls run on the calling thread
+    template <typename F>
+      void run_threads(std::size_t count, F &&f) noexcept {
+        std::vector<std::jthread> workers;
+        workers.reserve(count - 1);
+        size_t t = 1;
+        try {
+          for (; t < count; t++) {
+            workers.emplace_back([&f, t] { f(t); });
+          }
+        } catch (const std::system_error &) {
+          // thread limit reached, nothing was started for t
+        }
+        for (size_t rest = t; rest < count; rest++) {
+          f(rest);
+        }
+        f(size_t(0));
+      }
+
+    // same as reduce, but large inputs are split into chunks reduced on separate threads
+    template <typename E, typename A, typename Map, typename Op>
+      A reduce(ParallelTag, std::span<const E> in, const A &init, Map &&map, Op &&op) noexcept {
+        const size_t threads = std::min<size_t>(
+          std::max(std::thread::hardware_concurrency(), 1u), in.size() / parallel_reduce_chunk);
+        if (threads <= 1) {
+          return reduce(in, init, map, op);
+        }
+
+        std::vector<A> partial(threads, init);
+        const size_t chunk = (in.size() + threads - 1) / threads;
+        run_threads(threads, [&](size_t t) {
+          partial[t] = reduce(in.subspan(t * chunk, std::min(chunk, in.size() - t * chunk)), init, map, op);
+        });
+
+        A res = partial[0];
+        for (size_t t = 1; t < threads; t++) {
+          res = op(res, partial[t]);
+        }
+        return res;
+      }
+
+    // calls f(begin, end) for chunks of [0, size) on separate threads
+    // (inputs smaller than 2 * 'chunk' run on the calling thread)
+    // threads are started on every call, which costs tens of microseconds, so 'chunk' should be
+    // large enough to amortize it (e.g. hierarchies only split levels of 2 * 4096 nodes and more)
+    template <typename F>
+      void parallel_for(std::size_t size, std::size_t chunk, F &&f) noexcept {
+        const size_t threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), size / chunk);
+        if (threads <= 1) {
+          f(size_t(0), size);
+          return;
+        }
+
+        const size_t step = (size + threads - 1) / threads;
+        run_threads(threads, [&f, step, size](size_t t) { f(t * step, std::min(size, (t + 1) * step)); });
+      }
+
+    template <RowRangeT R>
+      constexpr auto as_span(const R &r) noexcept {
+        return std::span<const std::ranges::range_value_t<R>>(std::ranges::data(r), std::ranges::size(r));
+      }
+
+    template <RowLikeT D>
+      constexpr typename D::ValueT length2(const D &v) noexcept {
+        const auto &s = row_simd(v);
+        return (s * s).sum();
+      }
+  } // namespace details
+
+  // component-wise minimum (input must not be empty)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    [[nodiscard]] auto component_min(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      assert(std::ranges::size(r) > 0);
+      return mr::details::row_from_simd<D>(mr::details::reduce(policy..., mr::details::as_span(r),
+        mr::details::row_simd(*std::ranges::data(r)),
+        [](const D &v) { return mr::details::row_simd(v); },
+        [](const auto &a, const auto &b) { return stdx::min(a, b); }));
+    }
+
+  // component-wise maximum (input must not be empty)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    [[nodiscard]] auto component_max(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      assert(std::ranges::size(r) > 0);
+      return mr::details::row_from_simd<D>(mr::details::reduce(policy..., mr::details::as_span(r),
+        mr::details::row_simd(*std::ranges::data(r)),
+        [](const D &v) { return mr::details::row_simd(v); },
+        [](const auto &a, const auto &b) { return stdx::max(a, b); }));
+    }
+
+  // sum of all vectors (zero for empty input)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    [[nodiscard]] auto sum(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      return mr::details::row_from_simd<D>(mr::details::reduce(policy..., mr::details::as_span(r),
+        typename D::SimdT(0),
+        [](const D &v) { return mr::details::row_simd(v); },
+        [](const auto &a, const auto &b) { return a + b; }));
+    }
+
+  // centroid (input must not be empty)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    [[nodiscard]] auto mean(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      assert(std::ranges::size(r) > 0);
+      return mr::details::row_from_simd<D>(
+        mr::details::row_simd(sum(r, policy...)) / typename D::SimdT(static_cast<typename D::ValueT>(std::ranges::size(r))));
+    }
+
+  // bounding box of a point set (input must not be empty)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    requires std::same_as<std::ranges::range_value_t<R>, Vec3<typename std::ranges::range_value_t<R>::ValueT>>
+    [[nodiscard]] auto bounds(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      using SimdT = typename D::SimdT;
+      using MinMaxT = std::pair<SimdT, SimdT>;
+      assert(std::ranges::size(r) > 0);
+
+      const SimdT &first = mr::details::row_simd(*std::ranges::data(r));
+      const auto [min, max] = mr::details::reduce(policy..., mr::details::as_span(r),
+        MinMaxT{first, first},
+        [](const D &v) { return MinMaxT{mr::details::row_simd(v), mr::details::row_simd(v)}; },
+        [](const MinMaxT &a, const MinMaxT &b) {
+          return MinMaxT{stdx::min(a.first, b.first), stdx::max(a.second, b.second)};
+        });
+      return AABB<typename D::ValueT> {
+        mr::details::row_from_simd<D>(min),
+        mr::details::row_from_simd<D>(max)
+      };
+    }
+
+  // shortest vector length (input must not be empty)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    requires std::floating_point<typename std::ranges::range_value_t<R>::ValueT>
+    [[nodiscard]] auto min_length(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      assert(std::ranges::size(r) > 0);
+      return std::sqrt(mr::details::reduce(policy..., mr::details::as_span(r),
+        std::numeric_limits<typename D::ValueT>::infinity(),
+        [](const D &v) { return mr::details::length2(v); },
+        [](auto a, auto b) { return std::min(a, b); }));
+    }
+
+  // longest vector length (input must not be empty)
+  template <mr::details::RowRangeT R, std::same_as<ParallelTag> ...Policy>
+    requires std::floating_point<typename std::ranges::range_value_t<R>::ValueT>
+    [[nodiscard]] auto max_length(const R &r, Policy ...policy) noexcept {
+      using D = std::ranges::range_value_t<R>;
+      assert(std::ranges::size(r) > 0);
+      return std::sqrt(mr::details::reduce(policy..., mr::details::as_span(r),
+        typename D::ValueT(0),
+        [](const D &v) { return mr::details::length2(v); },
+        [](auto a, auto b) { return std::max(a, b); }));
+    }
+} // namespace mr
+
+#endif // __MR_REDUCE_HPP_
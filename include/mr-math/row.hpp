@@ -25,12 +25,11 @@ namespace mr {
 
       constexpr Row(const T data) : _data(data) {}
 
-// TODO: implement this usign Vc library
-#if 0
-      constexpr Row(const T *data) {
-        _data.copy_from(data, stdx::element_aligned);
-      }
-#endif
+      // from memory constructor (reads N elements)
+      template <typename Flags>
+        constexpr Row(const T *data, Flags flags) noexcept {
+          _data.load(data, flags);
+        }
 
       // from elements constructor
       template <ArithmeticT... Args>
@@ -77,6 +76,47 @@ namespace mr {
         }
 #endif
 
+      // load/store methods (see mr::aligned, mr::unaligned, mr::streaming)
+      [[nodiscard]] static constexpr Row load(const T *data) noexcept {
+        return Row(data, unaligned);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Row load(const T *data, Flags flags) noexcept {
+          return Row(data, flags);
+        }
+
+      [[nodiscard]] static constexpr Row load(std::span<const T> data) noexcept {
+        assert(data.size() >= N);
+        return Row(data.data(), unaligned);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Row load(std::span<const T> data, Flags flags) noexcept {
+          assert(data.size() >= N);
+          return Row(data.data(), flags);
+        }
+
+      constexpr void store(T *data) const noexcept {
+        _data.store(data, unaligned);
+      }
+
+      template <typename Flags>
+        constexpr void store(T *data, Flags flags) const noexcept {
+          _data.store(data, flags);
+        }
+
+      constexpr void store(std::span<T> data) const noexcept {
+        assert(data.size() >= N);
+        _data.store(data.data(), unaligned);
+      }
+
+      template <typename Flags>
+        constexpr void store(std::span<T> data, Flags flags) const noexcept {
+          assert(data.size() >= N);
+          _data.store(data.data(), flags);
+        }
+
       [[nodiscard]] constexpr T operator[](std::size_t i) const {
         return _data[i];
       }
@@ -117,6 +157,146 @@ namespace mr {
         // _data.copy_from(arr.data(), stdx::element_aligned);
       }
     };
+
+  // Row or type backed by a single Row (e.g. Vec)
+  template <typename T>
+    concept RowLikeT = requires (const T &v) {
+      typename T::ValueT;
+      typename T::SimdT;
+      requires std::same_as<typename T::SimdT, SimdImpl<typename T::ValueT, T::size>>;
+      v._data;
+    };
+
+  namespace details {
+    template <RowLikeT D>
+      MR_MATH_INLINE constexpr const typename D::SimdT & row_simd(const D &v) noexcept {
+        if constexpr (std::same_as<std::remove_cvref_t<decltype(v._data)>, typename D::SimdT>) {
+          return v._data;
+        } else {
+          return v._data._data;
+        }
+      }
+
+    template <RowLikeT D>
+      MR_MATH_INLINE constexpr D row_from_simd(const typename D::SimdT &v) noexcept {
+        if constexpr (std::same_as<std::remove_cvref_t<decltype(std::declval<D>()._data)>, typename D::SimdT>) {
+          return D(v);
+        } else {
+          return D(Row<typename D::ValueT, D::size>(v));
+        }
+      }
+
+    // a * b + c with one rounding where the target has fma, otherwise a multiply and an add
+    // (stdx::fma would fall back to a software emulation); without -mfma the compiler still
+    // contracts the expression in dispatched copies (see dispatch.hpp)
+    template <typename S>
+      MR_MATH_INLINE constexpr S fma_simd(const S &a, const S &b, const S &c) noexcept {
+#ifdef __FMA__
+        if constexpr (!ArithmeticT<S>) {
+          return stdx::fma(a, b, c);
+        }
+#endif
+        return a * b + c;
+      }
+
+#if defined(__GNUC__) || defined(__clang__)
+    // GCC/Clang vector extension register with N lanes of T (N is a power of two)
+    template <typename T, std::size_t N>
+      using VectorExt [[gnu::vector_size(N * sizeof(T))]] = T;
+
+    // SimdImpl keeps its N lanes first in memory, so they can be moved into
+    // a vector extension register of the next power of two width
+    template <typename T, std::size_t N>
+      inline constexpr bool vector_ext_compatible_v =
+        N >= 2 && N <= 16 && std::is_trivially_copyable_v<SimdImpl<T, N>> && sizeof(SimdImpl<T, N>) >= N * sizeof(T);
+
+    // elements I... of concat(a, b) with a single __builtin_shufflevector
+    // (J... are the lanes of the power of two wide result, the ones past sizeof...(I) are dropped)
+    template <std::size_t ...I, typename T, std::size_t N, std::size_t ...J>
+      MR_MATH_INLINE SimdImpl<T, sizeof...(I)> shuffle_vector_ext(
+          const SimdImpl<T, N> &a, const SimdImpl<T, N> &b, std::index_sequence<J...>) noexcept {
+        constexpr std::size_t width = std::bit_ceil(N);
+        static constexpr std::array<std::size_t, sizeof...(I)> lanes {(I < N ? I : I - N + width)...};
+
+        using InT = VectorExt<T, width>;
+        using ResT = SimdImpl<T, sizeof...(I)>;
+
+        InT va {}, vb {};
+        if constexpr (sizeof(SimdImpl<T, N>) == sizeof(InT)) {
+          va = __builtin_bit_cast(InT, a);
+          vb = __builtin_bit_cast(InT, b);
+        } else {
+          std::memcpy(&va, &a, N * sizeof(T));
+          std::memcpy(&vb, &b, N * sizeof(T));
+        }
+        const auto shuffled = __builtin_shufflevector(va, vb, (J < lanes.size() ? lanes[J] : 0)...);
+
+        if constexpr (sizeof(ResT) == sizeof(shuffled)) {
+          return __builtin_bit_cast(ResT, shuffled);
+        } else {
+          ResT res;
+          std::memcpy(static_cast<void *>(&res), &shuffled, sizeof...(I) * sizeof(T));
+          return res;
+        }
+      }
+#endif
+
+    // register with elements I... of concat(a, b)
+    // compiles to a register permute (shufps/vpermps/...), the generator is the constexpr and fallback path
+    template <std::size_t ...I, typename T, std::size_t N>
+      MR_MATH_INLINE constexpr SimdImpl<T, sizeof...(I)> shuffle_simd(const SimdImpl<T, N> &a, const SimdImpl<T, N> &b) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        if constexpr (vector_ext_compatible_v<T, N> && vector_ext_compatible_v<T, sizeof...(I)>) {
+          if !consteval {
+            return shuffle_vector_ext<I...>(a, b, std::make_index_sequence<std::bit_ceil(sizeof...(I))>{});
+          }
+        }
+#endif
+        static constexpr std::array<std::size_t, sizeof...(I)> indices {I...};
+        return SimdImpl<T, sizeof...(I)>([&a, &b](size_t i) { return indices[i] < N ? a[indices[i]] : b[indices[i] - N]; });
+      }
+
+    // register with elements I... of v
+    template <std::size_t ...I, RowLikeT D>
+      MR_MATH_INLINE constexpr SimdImpl<typename D::ValueT, sizeof...(I)> swizzle_simd(const D &v) noexcept {
+        const auto &s = row_simd(v);
+        return shuffle_simd<I...>(s, s);
+      }
+
+    // xyz parts of r0, r1, r2 transposed (w of the results is 0)
+    template <typename T>
+      MR_MATH_INLINE constexpr std::array<SimdImpl<T, 4>, 3> transpose3_simd(
+          const SimdImpl<T, 4> &r0, const SimdImpl<T, 4> &r1, const SimdImpl<T, 4> &r2) noexcept {
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT lo01 = shuffle_simd<0, 4, 1, 5>(r0, r1);
+        const SimdT hi01 = shuffle_simd<2, 6, 3, 7>(r0, r1);
+        const SimdT lo2 = shuffle_simd<0, 4, 1, 5>(r2, SimdT(0));
+        const SimdT hi2 = shuffle_simd<2, 6, 3, 7>(r2, SimdT(0));
+        return {
+          shuffle_simd<0, 1, 4, 5>(lo01, lo2),
+          shuffle_simd<2, 3, 6, 7>(lo01, lo2),
+          shuffle_simd<0, 1, 4, 5>(hi01, hi2)
+        };
+      }
+
+    // 4x4 transposition with two rounds of shuffles (like _MM_TRANSPOSE4_PS):
+    // unpcklps/unpckhps, then movlhps/movhlps on native registers
+    template <typename T>
+      MR_MATH_INLINE constexpr std::array<SimdImpl<T, 4>, 4> transpose4_simd(
+          const SimdImpl<T, 4> &r0, const SimdImpl<T, 4> &r1, const SimdImpl<T, 4> &r2, const SimdImpl<T, 4> &r3) noexcept {
+        using SimdT = SimdImpl<T, 4>;
+        const SimdT lo01 = shuffle_simd<0, 4, 1, 5>(r0, r1);
+        const SimdT hi01 = shuffle_simd<2, 6, 3, 7>(r0, r1);
+        const SimdT lo23 = shuffle_simd<0, 4, 1, 5>(r2, r3);
+        const SimdT hi23 = shuffle_simd<2, 6, 3, 7>(r2, r3);
+        return {
+          shuffle_simd<0, 1, 4, 5>(lo01, lo23),
+          shuffle_simd<2, 3, 6, 7>(lo01, lo23),
+          shuffle_simd<0, 1, 4, 5>(hi01, hi23),
+          shuffle_simd<2, 3, 6, 7>(hi01, hi23)
+        };
+      }
+  } // namespace details
 } // namespace mr
 
 #ifdef __cpp_lib_format
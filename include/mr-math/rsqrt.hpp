@@ -0,0 +1,90 @@
+#ifndef __MR_RSQRT_HPP_
+#define __MR_RSQRT_HPP_
+
+#include "def.hpp"
+#include "functions.hpp"
+
+#if defined(__SSE__) || defined(_M_X64)
+  #include <immintrin.h>
+#endif
+
+namespace mr {
+  // precision tiers of 1 / sqrt(x)
+  enum class RsqrtPrecision {
+    estimate, // hardware estimate (rsqrtps/rsqrtss, ~12 bits), see rsqrt_estimate for the exceptions
+    newton1,  // estimate refined by one Newton-Raphson step
+    newton2,  // estimate refined by two Newton-Raphson steps
+    exact,    // 1 / sqrt(x)
+  };
+
+  namespace details {
+    // y' = y * (1.5 - 0.5 * x * y * y)
+    template <typename S>
+      MR_MATH_INLINE constexpr S rsqrt_newton_step(const S &x, const S &y) noexcept {
+        if constexpr (ArithmeticT<S>) {
+          // no std::fma: it is a library call without hardware fma and blocks vectorization
+          return y * (S(1.5) - S(0.5) * x * y * y);
+        } else {
+          return y * fma_simd(S(-0.5) * x * y, y, S(1.5));
+        }
+      }
+
+    // ~12 bit 1 / sqrt(x) with rsqrtss, doubles go through float while they are in its range
+    // constant evaluation, non-x86 targets and doubles out of float range use fast_rsqrt (~5 bits)
+    template <std::floating_point T>
+      MR_MATH_INLINE constexpr T rsqrt_estimate(T x) noexcept {
+#if defined(__SSE__) || defined(_M_X64)
+        if !consteval {
+          if (std::same_as<T, float> ||
+              (x >= std::numeric_limits<float>::min() && x <= std::numeric_limits<float>::max())) {
+            return T(_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(float(x)))));
+          }
+        }
+#endif
+        return fast_rsqrt(x);
+      }
+  } // namespace details
+
+  // scalar 1 / sqrt(x)
+  template <RsqrtPrecision P = RsqrtPrecision::newton1, std::floating_point T>
+    [[nodiscard]] MR_MATH_INLINE constexpr T rsqrt(T x) noexcept {
+      if constexpr (P == RsqrtPrecision::exact) {
+        return 1 / std::sqrt(x);
+      } else {
+        T y = mr::details::rsqrt_estimate(x);
+        if constexpr (P == RsqrtPrecision::newton1 || P == RsqrtPrecision::newton2) {
+          y = mr::details::rsqrt_newton_step(x, y);
+        }
+        if constexpr (P == RsqrtPrecision::newton2) {
+          y = mr::details::rsqrt_newton_step(x, y);
+        }
+        return y;
+      }
+    }
+
+  // element-wise 1 / sqrt(x) for SimdImpl<T, N> and NativeSimdImpl<T>
+  template <RsqrtPrecision P = RsqrtPrecision::newton1, typename S>
+    requires requires (const S &x) { {stdx::rsqrt(x)} -> std::convertible_to<S>; }
+    [[nodiscard]] MR_MATH_INLINE constexpr S rsqrt(const S &x) noexcept {
+      if constexpr (P == RsqrtPrecision::exact) {
+        return S(1) / stdx::sqrt(x);
+      } else {
+        S y = stdx::rsqrt(x);
+        if constexpr (P == RsqrtPrecision::newton1 || P == RsqrtPrecision::newton2) {
+          y = mr::details::rsqrt_newton_step(x, y);
+        }
+        if constexpr (P == RsqrtPrecision::newton2) {
+          y = mr::details::rsqrt_newton_step(x, y);
+        }
+        return y;
+      }
+    }
+
+  // batch 1 / sqrt(x) over contiguous ranges
+  template <RsqrtPrecision P = RsqrtPrecision::newton1, mr::details::BatchRangeT X, mr::details::BatchRangeT O>
+    void rsqrt(const X &in, O &&out) noexcept {
+      mr::details::batch_apply(out, [](const auto &x) { return rsqrt<P>(x); }, in);
+    }
+} // namespace mr
+
+#endif // __MR_RSQRT_HPP_
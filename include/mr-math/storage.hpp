@@ -0,0 +1,264 @@
+#ifndef __MR_STORAGE_HPP_
+#define __MR_STORAGE_HPP_
+
+#include "def.hpp"
+#include "vec.hpp"
+#include "matr.hpp"
+
+namespace mr {
+  // forward declarations
+  template <ArithmeticT T, std::size_t N> requires (N >= 2)
+    struct PackedVec;
+  template <ArithmeticT T>
+    struct PaddedVec3;
+
+  // common aliases
+  template <ArithmeticT T>
+    using Vec2Packed = PackedVec<T, 2>;
+  template <ArithmeticT T>
+    using Vec3Packed = PackedVec<T, 3>;
+  template <ArithmeticT T>
+    using Vec4Packed = PackedVec<T, 4>;
+
+  using Vec2fPacked = Vec2Packed<float>;
+  using Vec3fPacked = Vec3Packed<float>;
+  using Vec4fPacked = Vec4Packed<float>;
+
+  using Vec2dPacked = Vec2Packed<double>;
+  using Vec3dPacked = Vec3Packed<double>;
+  using Vec4dPacked = Vec4Packed<double>;
+
+  using Vec3iPacked = Vec3Packed<int>;
+  using Vec3uPacked = Vec3Packed<uint32_t>;
+
+  using Vec3fPadded = PaddedVec3<float>;
+  using Vec3dPadded = PaddedVec3<double>;
+  using Vec3iPadded = PaddedVec3<int>;
+  using Vec3uPadded = PaddedVec3<uint32_t>;
+
+  // tightly packed storage for Vec<T, N> (e.g. 12 bytes for Vec3f)
+  // matches GPU vertex formats; convert to Vec<T, N> for arithmetic
+  template <ArithmeticT T, std::size_t N> requires (N >= 2)
+    struct [[nodiscard]] PackedVec {
+    public:
+      using ValueT = T;
+      using VecT = Vec<T, N>;
+      static constexpr size_t size = N;
+
+      std::array<T, N> _data {};
+
+      constexpr PackedVec() noexcept = default;
+
+      // from elements constructor
+      template <ArithmeticT... Args>
+      requires (sizeof...(Args) == N)
+        constexpr PackedVec(Args... args) noexcept : _data {static_cast<T>(args)...} {}
+
+      // from vector constructor
+      constexpr PackedVec(const VecT &v) noexcept {
+        v.store(_data.data());
+      }
+
+      constexpr operator VecT() const noexcept {
+        return VecT::load(_data.data());
+      }
+
+      // setters
+      constexpr void set(size_t i, T value) noexcept { _data[i] = value; }
+      constexpr void x(T x) noexcept requires (N >= 1) { _data[0] = x; }
+      constexpr void y(T y) noexcept requires (N >= 2) { _data[1] = y; }
+      constexpr void z(T z) noexcept requires (N >= 3) { _data[2] = z; }
+      constexpr void w(T w) noexcept requires (N >= 4) { _data[3] = w; }
+
+      // getters
+      [[nodiscard]] constexpr T x() const noexcept requires (N >= 1) { return _data[0]; }
+      [[nodiscard]] constexpr T y() const noexcept requires (N >= 2) { return _data[1]; }
+      [[nodiscard]] constexpr T z() const noexcept requires (N >= 3) { return _data[2]; }
+      [[nodiscard]] constexpr T w() const noexcept requires (N >= 4) { return _data[3]; }
+      [[nodiscard]] constexpr T operator[](std::size_t i) const { return _data[i]; }
+
+      // structured binding support
+      template <size_t I> requires (I < N) constexpr T get() const { return _data[I]; }
+
+      constexpr bool operator==(const PackedVec &other) const noexcept = default;
+
+      friend std::ostream & operator<<(std::ostream &os, const PackedVec &v) noexcept {
+        os << VecT(v);
+        return os;
+      }
+    };
+
+  // 3 component vector padded to a 4 lane register (w is kept 0)
+  // every operation maps to single register instructions; 16 bytes for float
+  template <ArithmeticT T>
+    struct [[nodiscard]] alignas(4 * sizeof(T)) PaddedVec3 {
+    public:
+      using ValueT = T;
+      using RowT = Row<T, 4>;
+      using SimdT = SimdImpl<T, 4>;
+      using VecT = Vec3<T>;
+      static constexpr size_t size = 3;
+
+      RowT _data;
+
+      constexpr PaddedVec3() noexcept = default;
+
+      // from elements constructor
+      template <ArithmeticT... Args>
+      requires (sizeof...(Args) >= 2) && (sizeof...(Args) <= 3)
+        constexpr PaddedVec3(Args... args) noexcept : _data(args...) {}
+
+      // from row constructor (w must be 0)
+      constexpr PaddedVec3(const RowT &row) noexcept : _data(row) {}
+
+      // conversions
+      constexpr PaddedVec3(const VecT &v) noexcept : _data(v._data) {}
+      constexpr PaddedVec3(const PackedVec<T, 3> &v) noexcept : PaddedVec3(v.x(), v.y(), v.z()) {}
+
+      constexpr operator VecT() const noexcept { return VecT(Vec4<T>(_data)); }
+      constexpr operator PackedVec<T, 3>() const noexcept { return {x(), y(), z()}; }
+
+      // setters
+      constexpr void set(size_t i, T value) noexcept { assert(i < 3); _data._set_ind(i, value); }
+      constexpr void x(T x) noexcept { set(0, x); }
+      constexpr void y(T y) noexcept { set(1, y); }
+      constexpr void z(T z) noexcept { set(2, z); }
+
+      // getters
+      [[nodiscard]] constexpr T x() const noexcept { return _data[0]; }
+      [[nodiscard]] constexpr T y() const noexcept { return _data[1]; }
+      [[nodiscard]] constexpr T z() const noexcept { return _data[2]; }
+      [[nodiscard]] constexpr T operator[](std::size_t i) const { return _data[i]; }
+
+      // structured binding support
+      template <size_t I> requires (I < 3) constexpr T get() const { return _data[I]; }
+
+      // arithmetic
+      // only operations which keep w == 0 are provided
+      friend constexpr PaddedVec3 operator+(const PaddedVec3 &lhs, const PaddedVec3 &rhs) noexcept {
+        return RowT{lhs._data + rhs._data};
+      }
+
+      friend constexpr PaddedVec3 operator-(const PaddedVec3 &lhs, const PaddedVec3 &rhs) noexcept {
+        return RowT{lhs._data - rhs._data};
+      }
+
+      friend constexpr PaddedVec3 operator*(const PaddedVec3 &lhs, const PaddedVec3 &rhs) noexcept {
+        return RowT{lhs._data * rhs._data};
+      }
+
+      friend constexpr PaddedVec3 operator*(const PaddedVec3 &lhs, const T rhs) noexcept {
+        return RowT{lhs._data * rhs};
+      }
+
+      friend constexpr PaddedVec3 operator*(const T lhs, const PaddedVec3 &rhs) noexcept {
+        return RowT{rhs._data * lhs};
+      }
+
+      friend constexpr PaddedVec3 operator/(const PaddedVec3 &lhs, const T rhs) noexcept {
+        return RowT{lhs._data / rhs};
+      }
+
+      friend constexpr PaddedVec3 operator-(const PaddedVec3 &rhs) noexcept {
+        return RowT{-rhs._data};
+      }
+
+      constexpr PaddedVec3 & operator+=(const PaddedVec3 &other) noexcept { _data += other._data; return *this; }
+      constexpr PaddedVec3 & operator-=(const PaddedVec3 &other) noexcept { _data -= other._data; return *this; }
+      constexpr PaddedVec3 & operator*=(const PaddedVec3 &other) noexcept { _data *= other._data; return *this; }
+      constexpr PaddedVec3 & operator*=(const T x) noexcept { _data *= x; return *this; }
+      constexpr PaddedVec3 & operator/=(const T x) noexcept { _data /= x; return *this; }
+
+      // cross product (w stays 0)
+      constexpr PaddedVec3 cross(const PaddedVec3 &other) const noexcept {
+        return RowT{mr::details::cross_simd(_data._data, other._data._data)};
+      }
+
+      constexpr PaddedVec3 operator%(const PaddedVec3 &other) const noexcept {
+        return cross(other);
+      }
+
+      // dot product
+      [[nodiscard]] constexpr T dot(const PaddedVec3 &other) const noexcept {
+        return (_data._data * other._data._data).sum();
+      }
+
+      [[nodiscard]] constexpr T operator&(const PaddedVec3 &other) const noexcept {
+        return dot(other);
+      }
+
+      // length methods
+      [[nodiscard]] constexpr T length2() const noexcept {
+        return dot(*this);
+      }
+
+      [[nodiscard]] constexpr T length() const noexcept {
+        return std::sqrt(length2());
+      }
+
+      // normalize methods
+      constexpr PaddedVec3 & normalize() noexcept {
+        auto len = length2();
+        if (len <= _epsilon) [[unlikely]] return *this;
+        *this /= std::sqrt(len);
+        return *this;
+      }
+
+      constexpr PaddedVec3 normalized_unchecked() const noexcept {
+        return *this / std::sqrt(length2());
+      }
+
+      constexpr bool operator==(const PaddedVec3 &other) const noexcept {
+        return _data == other._data;
+      }
+
+      constexpr bool equal(const PaddedVec3 &other, ValueT eps = epsilon<ValueT>()) const noexcept {
+        return _data.equal(other._data, eps);
+      }
+
+      friend std::ostream & operator<<(std::ostream &os, const PaddedVec3 &v) noexcept {
+        os << VecT(v);
+        return os;
+      }
+
+    private:
+      static constexpr T _epsilon = std::numeric_limits<T>::epsilon();
+    };
+
+  // layout guarantees
+  static_assert(sizeof(Vec3fPacked) == 3 * sizeof(float));
+  static_assert(alignof(Vec3fPacked) == alignof(float));
+  static_assert(sizeof(std::array<Vec3fPacked, 4>) == 12 * sizeof(float));
+  static_assert(std::is_trivially_copyable_v<Vec3fPacked>);
+
+  static_assert(sizeof(Vec3fPadded) == 4 * sizeof(float));
+  static_assert(alignof(Vec3fPadded) == 4 * sizeof(float));
+  static_assert(sizeof(Vec3dPadded) == 4 * sizeof(double));
+  static_assert(alignof(Vec3dPadded) == 4 * sizeof(double));
+} // namespace mr
+
+#ifdef __cpp_structured_bindings
+// specializations for structured binding support
+namespace std
+{
+  template <mr::ArithmeticT T, std::size_t N>
+  struct tuple_size<mr::PackedVec<T, N>>
+      : std::integral_constant<size_t, N> {};
+
+  template <mr::ArithmeticT T, std::size_t N, std::size_t I>
+  struct tuple_element<I, mr::PackedVec<T, N>> {
+    using type = T;
+  };
+
+  template <mr::ArithmeticT T>
+  struct tuple_size<mr::PaddedVec3<T>>
+      : std::integral_constant<size_t, 3> {};
+
+  template <mr::ArithmeticT T, std::size_t I>
+  struct tuple_element<I, mr::PaddedVec3<T>> {
+    using type = T;
+  };
+}
+#endif
+
+#endif // __MR_STORAGE_HPP_
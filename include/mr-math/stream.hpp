@@ -0,0 +1,425 @@
+#ifndef __MR_STREAM_HPP_
+#define __MR_STREAM_HPP_
+
+#include "def.hpp"
+#include "vec.hpp"
+#include "matr.hpp"
+#include "transform.hpp"
+#include "rsqrt.hpp"
+#include "dispatch.hpp"
+
+namespace mr {
+  // forward declarations
+  template <ArithmeticT T, std::size_t N> requires (N >= 2)
+    struct VecStream;
+
+  // common aliases
+  template <ArithmeticT T>
+    using VecStream2 = VecStream<T, 2>;
+  template <ArithmeticT T>
+    using VecStream3 = VecStream<T, 3>;
+  template <ArithmeticT T>
+    using VecStream4 = VecStream<T, 4>;
+
+  using VecStream2f = VecStream2<float>;
+  using VecStream3f = VecStream3<float>;
+  using VecStream4f = VecStream4<float>;
+
+  using VecStream2d = VecStream2<double>;
+  using VecStream3d = VecStream3<double>;
+  using VecStream4d = VecStream4<double>;
+
+  // block transposes between 4 (or 8) Vec4 and registers holding one component of every vector
+  //   auto [x, y, z, w] = mr::aos_to_soa<8>(points.data()); // x = {points[0].x(), ..., points[7].x()}
+  //   mr::soa_to_aos(std::array {x, y, z, w}, points.data());
+  template <std::size_t W = 4, ArithmeticT T> requires (W == 4 || W == 8)
+    [[nodiscard]] constexpr std::array<SimdImpl<T, W>, 4> aos_to_soa(const Vec4<T> *in) noexcept {
+      using mr::details::row_simd;
+      const auto lo = mr::details::transpose4_simd(row_simd(in[0]), row_simd(in[1]), row_simd(in[2]), row_simd(in[3]));
+      if constexpr (W == 4) {
+        return lo;
+      } else {
+        const auto hi = mr::details::transpose4_simd(row_simd(in[4]), row_simd(in[5]), row_simd(in[6]), row_simd(in[7]));
+        std::array<SimdImpl<T, W>, 4> res;
+        for (size_t c = 0; c < 4; c++) {
+          res[c] = mr::details::shuffle_simd<0, 1, 2, 3, 4, 5, 6, 7>(lo[c], hi[c]);
+        }
+        return res;
+      }
+    }
+
+  template <ArithmeticT T, std::size_t W> requires (W == 4 || W == 8)
+    constexpr void soa_to_aos(const std::array<SimdImpl<T, W>, 4> &in, Vec4<T> *out) noexcept {
+      using mr::details::row_from_simd;
+      if constexpr (W == 4) {
+        const auto [v0, v1, v2, v3] = mr::details::transpose4_simd(in[0], in[1], in[2], in[3]);
+        out[0] = row_from_simd<Vec4<T>>(v0);
+        out[1] = row_from_simd<Vec4<T>>(v1);
+        out[2] = row_from_simd<Vec4<T>>(v2);
+        out[3] = row_from_simd<Vec4<T>>(v3);
+      } else {
+        std::array<SimdImpl<T, 4>, 4> lo, hi;
+        for (size_t c = 0; c < 4; c++) {
+          lo[c] = mr::details::shuffle_simd<0, 1, 2, 3>(in[c], in[c]);
+          hi[c] = mr::details::shuffle_simd<4, 5, 6, 7>(in[c], in[c]);
+        }
+        soa_to_aos(lo, out);
+        soa_to_aos(hi, out + 4);
+      }
+    }
+
+  // runtime dispatched kernels (see dispatch.hpp)
+  namespace details {
+    // vectors normalized per block by stream_normalize (squared lengths of a block stay in L1)
+    inline constexpr std::size_t normalize_block = 256;
+
+    // vectors with length2 <= eps are left unchanged
+    // squared lengths and scaling are plain loops over the component arrays, which every dispatched
+    // copy vectorizes for its own register width; 1 / sqrt comes from the register version of rsqrt
+    // (hardware estimate), so that step keeps the NativeSimdImpl<T> width of the build target
+    template <std::floating_point T, std::size_t N, RsqrtPrecision P>
+      MR_MATH_KERNEL void stream_normalize_kernel(
+          std::array<T *, N> comps, std::size_t size, T eps, std::integral_constant<RsqrtPrecision, P>) noexcept {
+        using SimdT = NativeSimdImpl<T>;
+        static_assert(normalize_block % SimdT::size() == 0);
+        std::array<T, normalize_block> factor {};
+        for (size_t begin = 0; begin < size; begin += normalize_block) {
+          const size_t count = std::min(normalize_block, size - begin);
+          for (size_t i = 0; i < count; i++) {
+            T len2 = comps[0][begin + i] * comps[0][begin + i];
+            for (size_t c = 1; c < N; c++) {
+              len2 += comps[c][begin + i] * comps[c][begin + i];
+            }
+            factor[i] = len2;
+          }
+          for (size_t i = 0; i < count; i += SimdT::size()) {
+            const SimdT len2(factor.data() + i, unaligned);
+            stdx::iif(len2 <= SimdT(eps), SimdT(1), rsqrt<P>(len2)).store(factor.data() + i, unaligned);
+          }
+          for (size_t c = 0; c < N; c++) {
+            for (size_t i = 0; i < count; i++) {
+              comps[c][begin + i] *= factor[i];
+            }
+          }
+        }
+      }
+    MR_MATH_DISPATCHED(stream_normalize)
+
+    // 'v * m' where m holds 3 rows of the 3x3 part followed by the translation
+    template <ArithmeticT T>
+      MR_MATH_KERNEL void stream_transform_kernel(T *x, T *y, T *z, std::size_t size, std::array<T, 12> m) noexcept {
+        for (size_t i = 0; i < size; i++) {
+          const T vx = x[i], vy = y[i], vz = z[i];
+          x[i] = vx * m[0] + vy * m[3] + vz * m[6] + m[9];
+          y[i] = vx * m[1] + vy * m[4] + vz * m[7] + m[10];
+          z[i] = vx * m[2] + vy * m[5] + vz * m[8] + m[11];
+        }
+      }
+    MR_MATH_DISPATCHED(stream_transform)
+  } // namespace details
+
+  // structure-of-arrays container of Vec<T, N>
+  // every component is stored in its own array padded to the native register width,
+  // so batch methods process NativeSimdImpl<T>::size() vectors per instruction
+  template <ArithmeticT T, std::size_t N> requires (N >= 2)
+    struct [[nodiscard]] VecStream {
+    public:
+      using ValueT = T;
+      using VecT = Vec<T, N>;
+      using SimdT = NativeSimdImpl<T>;
+      static constexpr size_t width = SimdT::size();
+
+      VecStream() noexcept = default;
+
+      explicit VecStream(std::size_t count) {
+        resize(count);
+      }
+
+      // from AoS constructor
+      VecStream(std::span<const VecT> vecs) {
+        copy_from(vecs);
+      }
+
+      // AoS -> SoA (Vec4 streams are converted in blocks of 4, see aos_to_soa)
+      void copy_from(std::span<const VecT> vecs) {
+        resize(vecs.size());
+        size_t i = 0;
+        if constexpr (N == 4) {
+          for (; i + 4 <= vecs.size(); i += 4) {
+            const auto block = aos_to_soa(vecs.data() + i);
+            for (size_t c = 0; c < N; c++) {
+              block[c].store(_data[c].data() + i, unaligned);
+            }
+          }
+        }
+        for (; i < vecs.size(); i++) {
+          set(i, vecs[i]);
+        }
+      }
+
+      // SoA -> AoS (Vec4 streams are converted in blocks of 4, see soa_to_aos)
+      void copy_to(std::span<VecT> vecs) const noexcept {
+        assert(vecs.size() >= _size);
+        size_t i = 0;
+        if constexpr (N == 4) {
+          for (; i + 4 <= _size; i += 4) {
+            std::array<SimdImpl<T, 4>, 4> block;
+            for (size_t c = 0; c < N; c++) {
+              block[c] = SimdImpl<T, 4>(_data[c].data() + i, unaligned);
+            }
+            soa_to_aos(block, vecs.data() + i);
+          }
+        }
+        for (; i < _size; i++) {
+          vecs[i] = (*this)[i];
+        }
+      }
+
+      // size methods
+      [[nodiscard]] std::size_t size() const noexcept { return _size; }
+      [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+      void resize(std::size_t count) {
+        const size_t padded = (count + width - 1) / width * width;
+        for (auto &comp : _data) {
+          comp.resize(padded);
+          // keep padding lanes zeroed
+          std::fill(comp.begin() + count, comp.end(), T{});
+        }
+        _size = count;
+      }
+
+      void clear() noexcept {
+        for (auto &comp : _data) {
+          comp.clear();
+        }
+        _size = 0;
+      }
+
+      // grows by one register block of zeroed lanes at a time, only the new element is written
+      void push_back(const VecT &v) {
+        if (_size == _data[0].size()) {
+          for (auto &comp : _data) {
+            comp.resize(comp.size() + width);
+          }
+        }
+        _size++;
+        set(_size - 1, v);
+      }
+
+      // setters
+      void set(std::size_t i, const VecT &v) noexcept {
+        assert(i < _size);
+        for (size_t c = 0; c < N; c++) {
+          _data[c][i] = v[c];
+        }
+      }
+
+      // getters
+      [[nodiscard]] VecT operator[](std::size_t i) const noexcept {
+        assert(i < _size);
+        return typename VecT::RowT(SimdImpl<T, N>([this, i](size_t c) { return _data[c][i]; }));
+      }
+
+      // component arrays
+      [[nodiscard]] std::span<T> component(std::size_t c) noexcept { return {_data[c].data(), _size}; }
+      [[nodiscard]] std::span<const T> component(std::size_t c) const noexcept { return {_data[c].data(), _size}; }
+      [[nodiscard]] std::span<const T> x() const noexcept requires (N >= 1) { return component(0); }
+      [[nodiscard]] std::span<const T> y() const noexcept requires (N >= 2) { return component(1); }
+      [[nodiscard]] std::span<const T> z() const noexcept requires (N >= 3) { return component(2); }
+      [[nodiscard]] std::span<const T> w() const noexcept requires (N >= 4) { return component(3); }
+
+      // element-wise arithmetic
+      VecStream & operator+=(const VecStream &other) noexcept {
+        return _apply(other, [](const SimdT &l, const SimdT &r) { return l + r; });
+      }
+
+      VecStream & operator-=(const VecStream &other) noexcept {
+        return _apply(other, [](const SimdT &l, const SimdT &r) { return l - r; });
+      }
+
+      VecStream & operator*=(const VecStream &other) noexcept {
+        return _apply(other, [](const SimdT &l, const SimdT &r) { return l * r; });
+      }
+
+      VecStream & operator*=(const T x) noexcept {
+        return _apply(SimdT(x), [](const SimdT &l, const SimdT &r) { return l * r; });
+      }
+
+      VecStream & operator/=(const T x) noexcept {
+        return _apply(SimdT(x), [](const SimdT &l, const SimdT &r) { return l / r; });
+      }
+
+      friend VecStream operator+(VecStream lhs, const VecStream &rhs) noexcept {
+        lhs += rhs;
+        return lhs;
+      }
+
+      friend VecStream operator-(VecStream lhs, const VecStream &rhs) noexcept {
+        lhs -= rhs;
+        return lhs;
+      }
+
+      friend VecStream operator*(VecStream lhs, const VecStream &rhs) noexcept {
+        lhs *= rhs;
+        return lhs;
+      }
+
+      friend VecStream operator*(VecStream lhs, const T rhs) noexcept {
+        lhs *= rhs;
+        return lhs;
+      }
+
+      friend VecStream operator*(const T lhs, VecStream rhs) noexcept {
+        rhs *= lhs;
+        return rhs;
+      }
+
+      friend VecStream operator/(VecStream lhs, const T rhs) noexcept {
+        lhs /= rhs;
+        return lhs;
+      }
+
+      // dot product of each pair of vectors
+      void dot(const VecStream &other, std::span<T> out) const noexcept {
+        assert(_size == other._size);
+        _store_scalars(out, [this, &other](size_t i) { return _dot(other, i); });
+      }
+
+      // cross product of each pair of vectors
+      VecStream cross(const VecStream &other) const requires (N == 3) {
+        assert(_size == other._size);
+        VecStream res(_size);
+        for (size_t i = 0; i < _data[0].size(); i += width) {
+          const SimdT ax = _load(0, i), ay = _load(1, i), az = _load(2, i);
+          const SimdT bx = other._load(0, i), by = other._load(1, i), bz = other._load(2, i);
+          res._store(0, i, ay * bz - az * by);
+          res._store(1, i, az * bx - ax * bz);
+          res._store(2, i, ax * by - ay * bx);
+        }
+        return res;
+      }
+
+      // length methods
+      void length2(std::span<T> out) const noexcept {
+        _store_scalars(out, [this](size_t i) { return _dot(*this, i); });
+      }
+
+      void length(std::span<T> out) const noexcept requires std::floating_point<T> {
+        _store_scalars(out, [this](size_t i) { return stdx::sqrt(_dot(*this, i)); });
+      }
+
+      // normalize methods
+      // vectors with length near to zero are left unchanged (same as Vec::normalize)
+      // runtime dispatched (see dispatch.hpp)
+      VecStream & normalize() noexcept requires std::floating_point<T> {
+        return normalize_fast<RsqrtPrecision::exact>();
+      }
+
+      // use normalize() for higher precision (see RsqrtPrecision)
+      // runtime dispatched (see dispatch.hpp)
+      template <RsqrtPrecision P = RsqrtPrecision::newton1>
+        VecStream & normalize_fast() noexcept requires std::floating_point<T> {
+          mr::details::stream_normalize(_comps(), _size, _epsilon, std::integral_constant<RsqrtPrecision, P>{});
+          return *this;
+        }
+
+      // 'v * m' for every vector as a point (w == 1)
+      // runtime dispatched (see dispatch.hpp)
+      VecStream & transform_points(const Matr4<T> &m) noexcept requires (N == 3) {
+        return _transform(m, true);
+      }
+
+      // 'v * m' for every vector as a direction (w == 0, translation is ignored)
+      // runtime dispatched (see dispatch.hpp)
+      VecStream & transform_directions(const Matr4<T> &m) noexcept requires (N == 3) {
+        return _transform(m, false);
+      }
+
+      bool operator==(const VecStream &other) const noexcept {
+        if (_size != other._size) {
+          return false;
+        }
+        for (size_t c = 0; c < N; c++) {
+          if (!std::equal(_data[c].begin(), _data[c].begin() + _size, other._data[c].begin())) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+    private:
+      std::array<T *, N> _comps() noexcept {
+        std::array<T *, N> comps;
+        for (size_t c = 0; c < N; c++) {
+          comps[c] = _data[c].data();
+        }
+        return comps;
+      }
+
+      VecStream & _transform(const Matr4<T> &m, bool translate) noexcept {
+        mr::details::stream_transform(_data[0].data(), _data[1].data(), _data[2].data(), _size,
+                                      mr::details::transform_rows(m, translate));
+        return *this;
+      }
+
+      SimdT _load(std::size_t c, std::size_t i) const noexcept {
+        return SimdT(_data[c].data() + i, unaligned);
+      }
+
+      void _store(std::size_t c, std::size_t i, const SimdT &v) noexcept {
+        v.store(_data[c].data() + i, unaligned);
+      }
+
+      SimdT _dot(const VecStream &other, std::size_t i) const noexcept {
+        SimdT res = _load(0, i) * other._load(0, i);
+        for (size_t c = 1; c < N; c++) {
+          res += _load(c, i) * other._load(c, i);
+        }
+        return res;
+      }
+
+      template <typename F>
+        VecStream & _apply(const VecStream &other, F &&op) noexcept {
+          assert(_size == other._size);
+          for (size_t c = 0; c < N; c++) {
+            for (size_t i = 0; i < _data[c].size(); i += width) {
+              _store(c, i, op(_load(c, i), other._load(c, i)));
+            }
+          }
+          return *this;
+        }
+
+      template <typename F>
+        VecStream & _apply(const SimdT &x, F &&op) noexcept {
+          for (size_t c = 0; c < N; c++) {
+            for (size_t i = 0; i < _data[c].size(); i += width) {
+              _store(c, i, op(_load(c, i), x));
+            }
+          }
+          return *this;
+        }
+
+      // writes one scalar per vector; output span is not padded so the tail goes through a buffer
+      template <typename F>
+        void _store_scalars(std::span<T> out, F &&kernel) const noexcept {
+          assert(out.size() >= _size);
+          size_t i = 0;
+          for (; i + width <= _size; i += width) {
+            kernel(i).store(out.data() + i, unaligned);
+          }
+          if (i < _size) {
+            std::array<T, width> tail;
+            kernel(i).store(tail.data(), unaligned);
+            std::copy_n(tail.begin(), _size - i, out.begin() + i);
+          }
+        }
+
+      std::array<std::vector<T>, N> _data;
+      std::size_t _size = 0;
+
+      static constexpr T _epsilon = std::numeric_limits<T>::epsilon();
+    };
+} // namespace mr
+
+#endif // __MR_STREAM_HPP_
@@ -0,0 +1,337 @@
+#ifndef __MR_TRANSFORM_HPP_
+#define __MR_TRANSFORM_HPP_
+
+#include "def.hpp"
+#include "vec.hpp"
+#include "matr.hpp"
+#include "reduce.hpp"
+#include "dispatch.hpp"
+#include "wide.hpp"
+
+namespace mr {
+  namespace details {
+    // vectors transformed per block by transform_aos (components of a block stay in L1)
+    inline constexpr std::size_t transform_block = 256;
+
+    // out[i] = in[i] * m, m holds the first 3 columns of the matrix rows (zero translation row for directions)
+    // every block is split into x, y and z arrays, so the arithmetic is a plain loop over them which each
+    // dispatched copy vectorizes for its own register width; 'in' and 'out' may be the same array
+    template <ArithmeticT T>
+      MR_MATH_KERNEL void transform_aos_kernel(const Vec3<T> *in, Vec3<T> *out, std::size_t size, std::array<T, 12> m) noexcept {
+        std::array<T, transform_block> x, y, z;
+        for (size_t begin = 0; begin < size; begin += transform_block) {
+          const size_t count = std::min(transform_block, size - begin);
+          for (size_t i = 0; i < count; i++) {
+            x[i] = in[begin + i].x();
+            y[i] = in[begin + i].y();
+            z[i] = in[begin + i].z();
+          }
+          for (size_t i = 0; i < count; i++) {
+            const T vx = x[i], vy = y[i], vz = z[i];
+            x[i] = vx * m[0] + vy * m[3] + vz * m[6] + m[9];
+            y[i] = vx * m[1] + vy * m[4] + vz * m[7] + m[10];
+            z[i] = vx * m[2] + vy * m[5] + vz * m[8] + m[11];
+          }
+          for (size_t i = 0; i < count; i++) {
+            out[begin + i] = Vec3<T>(x[i], y[i], z[i]);
+          }
+        }
+      }
+    MR_MATH_DISPATCHED(transform_aos)
+
+    // first 3 columns of the rows of m, translation is zeroed for directions
+    template <ArithmeticT T>
+      constexpr std::array<T, 12> transform_rows(const Matr4<T> &m, bool translate) noexcept {
+        std::array<T, 12> rows;
+        for (size_t r = 0; r < 4; r++) {
+          for (size_t c = 0; c < 3; c++) {
+            rows[r * 3 + c] = r < 3 || translate ? m[r][c] : T{};
+          }
+        }
+        return rows;
+      }
+
+    // lane-wise determinants of matrices given by their row-major elements (S is a register or a scalar)
+    template <typename S>
+      MR_MATH_INLINE constexpr S determinant4_kernel(const std::array<S, 16> &m) noexcept {
+        // 2x2 minors of rows 0, 1 and rows 2, 3
+        const S s0 = m[0] * m[5] - m[1] * m[4];
+        const S s1 = m[0] * m[6] - m[2] * m[4];
+        const S s2 = m[0] * m[7] - m[3] * m[4];
+        const S s3 = m[1] * m[6] - m[2] * m[5];
+        const S s4 = m[1] * m[7] - m[3] * m[5];
+        const S s5 = m[2] * m[7] - m[3] * m[6];
+        const S c0 = m[8] * m[13] - m[9] * m[12];
+        const S c1 = m[8] * m[14] - m[10] * m[12];
+        const S c2 = m[8] * m[15] - m[11] * m[12];
+        const S c3 = m[9] * m[14] - m[10] * m[13];
+        const S c4 = m[9] * m[15] - m[11] * m[13];
+        const S c5 = m[10] * m[15] - m[11] * m[14];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+      }
+
+    template <typename S>
+      MR_MATH_INLINE constexpr S determinant3_kernel(const std::array<S, 9> &m) noexcept {
+        return m[0] * (m[4] * m[8] - m[5] * m[7]) -
+               m[1] * (m[3] * m[8] - m[5] * m[6]) +
+               m[2] * (m[3] * m[7] - m[4] * m[6]);
+      }
+
+    // out[i] = determinant of the upper left N x N part of in[i]
+    // native registers, NativeSimdImpl<T>::size() matrices per iteration (SoA lanes, scalar tail)
+    template <std::size_t N, ArithmeticT T, typename K>
+      void determinant_span(std::span<const Matr4<T>> in, std::span<T> out, K &&kernel) noexcept {
+        using SimdT = NativeSimdImpl<T>;
+        constexpr size_t width = SimdT::size();
+        assert(out.size() >= in.size());
+
+        size_t i = 0;
+        for (; i + width <= in.size(); i += width) {
+          std::array<SimdT, N * N> m;
+          for (size_t e = 0; e < N * N; e++) {
+            m[e] = SimdT::generate([&](size_t l) { return in[i + l][e / N][e % N]; });
+          }
+          kernel(m).store(out.data() + i, unaligned);
+        }
+        for (; i < in.size(); i++) {
+          std::array<T, N * N> m;
+          for (size_t e = 0; e < N * N; e++) {
+            m[e] = in[i][e / N][e % N];
+          }
+          out[i] = kernel(m);
+        }
+      }
+
+    template <typename R>
+      concept Matr4RangeT = std::ranges::contiguous_range<R> &&
+        std::same_as<std::ranges::range_value_t<R>, Matr4<typename std::ranges::range_value_t<R>::ValueT>>;
+
+    // how many matrices ahead of the current one are prefetched
+    inline constexpr std::size_t multiply_prefetch_distance = 8;
+    // spans shorter than 2 * this are never split across threads
+    inline constexpr std::size_t parallel_multiply_chunk = 1 << 13;
+
+    inline void prefetch(const void *p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(p);
+#endif
+    }
+
+    // a * b where b is given by its rows
+    template <ArithmeticT T>
+      constexpr Matr4<T> multiply_rows(const Matr4<T> &a,
+          const SimdImpl<T, 4> &b0, const SimdImpl<T, 4> &b1, const SimdImpl<T, 4> &b2, const SimdImpl<T, 4> &b3) noexcept {
+        Matr4<T> res;
+        for (size_t i = 0; i < 4; i++) {
+          const SimdImpl<T, 4> &r = a[i]._data;
+          res[i] = r[0] * b0 + r[1] * b1 + r[2] * b2 + r[3] * b3;
+        }
+        return res;
+      }
+
+    // out[i] = a[i * a_stride] * b[i * b_stride] for i in [begin, end) (stride 0 shares a matrix)
+    // uses wide registers when mr::active_isa() allows it (see wide.hpp), otherwise
+    // out[i] = product(i) unrolled by 2 with inputs prefetched multiply_prefetch_distance matrices ahead
+    template <ArithmeticT T, typename F>
+      void multiply_range(const Matr4<T> *a, std::size_t a_stride, const Matr4<T> *b, std::size_t b_stride,
+                          Matr4<T> *out, std::size_t begin, std::size_t end, F &&product) noexcept {
+        if constexpr (std::same_as<T, float> || std::same_as<T, double>) {
+          static_assert(sizeof(Matr4<T>) == 16 * sizeof(T));
+          if (mul4x4_batch(reinterpret_cast<const T *>(a + begin * a_stride), 16 * a_stride,
+                           reinterpret_cast<const T *>(b + begin * b_stride), 16 * b_stride,
+                           reinterpret_cast<T *>(out + begin), end - begin, multiply_prefetch_distance)) {
+            return;
+          }
+        }
+
+        size_t i = begin;
+        for (; i + 2 <= end; i += 2) {
+          if (i + multiply_prefetch_distance < end) {
+            if (a_stride != 0) {
+              prefetch(a + i + multiply_prefetch_distance);
+            }
+            if (b_stride != 0) {
+              prefetch(b + i + multiply_prefetch_distance);
+            }
+          }
+          const Matr4<T> m0 = product(i);
+          const Matr4<T> m1 = product(i + 1);
+          out[i] = m0;
+          out[i + 1] = m1;
+        }
+        for (; i < end; i++) {
+          out[i] = product(i);
+        }
+      }
+
+    template <ArithmeticT T, typename F, std::same_as<ParallelTag> ...Policy>
+      void multiply_span(const Matr4<T> *a, std::size_t a_stride, const Matr4<T> *b, std::size_t b_stride,
+                         Matr4<T> *out, std::size_t size, F &&product, Policy ...) noexcept {
+        if constexpr (sizeof...(Policy) == 0) {
+          multiply_range<T>(a, a_stride, b, b_stride, out, 0, size, product);
+        } else {
+          parallel_for(size, parallel_multiply_chunk, [&](size_t begin, size_t end) {
+            multiply_range<T>(a, a_stride, b, b_stride, out, begin, end, product);
+          });
+        }
+      }
+  } // namespace details
+
+  // batched 'v * m' for points (w == 1)
+  // 'in' and 'out' may be the same span, runtime dispatched (see dispatch.hpp)
+  template <ArithmeticT T>
+    void transform_points(
+        std::type_identity_t<std::span<const Vec3<T>>> in,
+        const Matr4<T> &m,
+        std::type_identity_t<std::span<Vec3<T>>> out) noexcept {
+      assert(out.size() >= in.size());
+      mr::details::transform_aos(in.data(), out.data(), in.size(), mr::details::transform_rows(m, true));
+    }
+
+  // batched 'v * m' for directions (w == 0, translation is ignored)
+  // 'in' and 'out' may be the same span, runtime dispatched (see dispatch.hpp)
+  template <ArithmeticT T>
+    void transform_directions(
+        std::type_identity_t<std::span<const Vec3<T>>> in,
+        const Matr4<T> &m,
+        std::type_identity_t<std::span<Vec3<T>>> out) noexcept {
+      assert(out.size() >= in.size());
+      mr::details::transform_aos(in.data(), out.data(), in.size(), mr::details::transform_rows(m, false));
+    }
+
+  // batched 'a[i] * b' (b stays in registers)
+  // 'out' may be the same range as 'a', mr::parallel splits large inputs across threads
+  template <mr::details::Matr4RangeT A, ArithmeticT T, mr::details::Matr4RangeT O, std::same_as<ParallelTag> ...Policy>
+    void multiply(const A &a, const Matr4<T> &b, O &&out, Policy ...policy) noexcept {
+      assert(std::ranges::size(out) >= std::ranges::size(a));
+      const Matr4<T> *src = std::ranges::data(a);
+      const SimdImpl<T, 4> b0 = b[0]._data, b1 = b[1]._data, b2 = b[2]._data, b3 = b[3]._data;
+      mr::details::multiply_span<T>(src, 1, &b, 0, std::ranges::data(out), std::ranges::size(a),
+        [&](size_t i) { return mr::details::multiply_rows(src[i], b0, b1, b2, b3); }, policy...);
+    }
+
+  // batched 'a * b[i]'
+  template <ArithmeticT T, mr::details::Matr4RangeT B, mr::details::Matr4RangeT O, std::same_as<ParallelTag> ...Policy>
+    void multiply(const Matr4<T> &a, const B &b, O &&out, Policy ...policy) noexcept {
+      assert(std::ranges::size(out) >= std::ranges::size(b));
+      const Matr4<T> *src = std::ranges::data(b);
+      mr::details::multiply_span<T>(&a, 0, src, 1, std::ranges::data(out), std::ranges::size(b),
+        [&](size_t i) { return a * src[i]; }, policy...);
+    }
+
+  // batched 'a[i] * b[i]' (e.g. parent * local in hierarchies)
+  template <mr::details::Matr4RangeT A, mr::details::Matr4RangeT B, mr::details::Matr4RangeT O, std::same_as<ParallelTag> ...Policy>
+    void multiply(const A &a, const B &b, O &&out, Policy ...policy) noexcept {
+      using T = typename std::ranges::range_value_t<A>::ValueT;
+      assert(std::ranges::size(b) >= std::ranges::size(a) && std::ranges::size(out) >= std::ranges::size(a));
+      const Matr4<T> *lhs = std::ranges::data(a), *rhs = std::ranges::data(b);
+      mr::details::multiply_span<T>(lhs, 1, rhs, 1, std::ranges::data(out), std::ranges::size(a),
+        [&](size_t i) {
+          const Matr4<T> &r = rhs[i];
+          return mr::details::multiply_rows(lhs[i], r[0]._data, r[1]._data, r[2]._data, r[3]._data);
+        }, policy...);
+    }
+
+  // batched 'm.transposed()'
+  // 'out' may be the same range as 'in', uses the widest kernels mr::active_isa() allows (see wide.hpp)
+  template <mr::details::Matr4RangeT I, mr::details::Matr4RangeT O>
+    void transpose(const I &in, O &&out) noexcept {
+      using T = typename std::ranges::range_value_t<I>::ValueT;
+      assert(std::ranges::size(out) >= std::ranges::size(in));
+      const Matr4<T> *src = std::ranges::data(in);
+      Matr4<T> *dst = std::ranges::data(out);
+      if constexpr (std::same_as<T, float> || std::same_as<T, double>) {
+        if (mr::details::transpose4x4_batch(reinterpret_cast<const T *>(src), reinterpret_cast<T *>(dst), std::ranges::size(in))) {
+          return;
+        }
+      }
+      for (size_t i = 0; i < std::ranges::size(in); i++) {
+        dst[i] = src[i].transposed();
+      }
+    }
+
+  // batched 'm.determinant()' (native registers, NativeSimdImpl<T>::size() matrices per iteration)
+  template <std::ranges::contiguous_range I, std::ranges::contiguous_range O>
+    requires std::same_as<std::ranges::range_value_t<I>, Matr4<std::ranges::range_value_t<O>>>
+    void determinant(const I &in, O &&out) noexcept {
+      using T = std::ranges::range_value_t<O>;
+      mr::details::determinant_span<4, T>(
+        std::span<const Matr4<T>>(std::ranges::data(in), std::ranges::size(in)),
+        std::span<T>(std::ranges::data(out), std::ranges::size(out)),
+        [](const auto &m) { return mr::details::determinant4_kernel(m); });
+    }
+
+  // batched 'm.determinant3()' (e.g. to find mirroring instance transforms)
+  template <std::ranges::contiguous_range I, std::ranges::contiguous_range O>
+    requires std::same_as<std::ranges::range_value_t<I>, Matr4<std::ranges::range_value_t<O>>>
+    void determinant3(const I &in, O &&out) noexcept {
+      using T = std::ranges::range_value_t<O>;
+      mr::details::determinant_span<3, T>(
+        std::span<const Matr4<T>>(std::ranges::data(in), std::ranges::size(in)),
+        std::span<T>(std::ranges::data(out), std::ranges::size(out)),
+        [](const auto &m) { return mr::details::determinant3_kernel(m); });
+    }
+
+  // batched 'Matr4<T>::rotate(axes[i], angles[i])' (native registers, NativeSimdImpl<T>::size() matrices per iteration)
+  template <std::ranges::contiguous_range A, std::ranges::contiguous_range R, mr::details::Matr4RangeT O>
+    requires std::same_as<std::ranges::range_value_t<A>, Norm3<typename std::ranges::range_value_t<O>::ValueT>> &&
+             std::same_as<std::ranges::range_value_t<R>, Radians<typename std::ranges::range_value_t<O>::ValueT>>
+    void rotate(const A &axes, const R &angles, O &&out) noexcept {
+      using T = typename std::ranges::range_value_t<O>::ValueT;
+      using SimdT = NativeSimdImpl<T>;
+      using RowT = Row<T, 4>;
+      constexpr size_t width = SimdT::size();
+      const size_t n = std::ranges::size(axes);
+      assert(std::ranges::size(angles) >= n && std::ranges::size(out) >= n);
+      const auto *axis = std::ranges::data(axes);
+      const auto *angle = std::ranges::data(angles);
+      auto *dst = std::ranges::data(out);
+
+      size_t i = 0;
+      for (; i + width <= n; i += width) {
+        SimdT si, co;
+        mr::details::sincos(SimdT::generate([angle, i](size_t l) { return angle[i + l]._data; }), si, co);
+        const auto m = mr::details::rotate_kernel<SimdT>({
+          SimdT::generate([axis, i](size_t l) { return axis[i + l].x(); }),
+          SimdT::generate([axis, i](size_t l) { return axis[i + l].y(); }),
+          SimdT::generate([axis, i](size_t l) { return axis[i + l].z(); })
+        }, si, co);
+        for (size_t l = 0; l < width; l++) {
+          dst[i + l] = Matr4<T> {
+            RowT(m[0][0][l], m[0][1][l], m[0][2][l], 0),
+            RowT(m[1][0][l], m[1][1][l], m[1][2][l], 0),
+            RowT(m[2][0][l], m[2][1][l], m[2][2][l], 0),
+            RowT(0, 0, 0, 1)
+          };
+        }
+      }
+      for (; i < n; i++) {
+        dst[i] = Matr4<T>::rotate(axis[i], angle[i]);
+      }
+    }
+
+  // batched 'm.normal_matrix()'
+  // 'out' holds Matr3 or 3x4 matrices (rows padded with 0, e.g. std140 mat3 uniforms)
+  template <mr::details::Matr4RangeT I, std::ranges::contiguous_range O>
+    requires std::same_as<std::ranges::range_value_t<O>, Matr3<typename std::ranges::range_value_t<I>::ValueT>> ||
+             std::same_as<std::ranges::range_value_t<O>, Matr<typename std::ranges::range_value_t<I>::ValueT, 3, 4>>
+    void normal_matrix(const I &in, O &&out) noexcept {
+      using OutT = std::ranges::range_value_t<O>;
+      using RowT = typename OutT::RowT;
+      using mr::details::shuffle_simd;
+      const size_t n = std::ranges::size(in);
+      assert(std::ranges::size(out) >= n);
+      const auto *src = std::ranges::data(in);
+      auto *dst = std::ranges::data(out);
+      for (size_t i = 0; i < n; i++) {
+        const auto [n0, n1, n2] = mr::details::normal_rows_simd(src[i][0]._data, src[i][1]._data, src[i][2]._data);
+        if constexpr (OutT::cols == 4) {
+          dst[i] = OutT {RowT(n0), RowT(n1), RowT(n2)};
+        } else {
+          dst[i] = OutT {RowT(shuffle_simd<0, 1, 2>(n0, n0)), RowT(shuffle_simd<0, 1, 2>(n1, n1)), RowT(shuffle_simd<0, 1, 2>(n2, n2))};
+        }
+      }
+    }
+} // namespace mr
+
+#endif // __MR_TRANSFORM_HPP_
@@ -0,0 +1,128 @@
+#ifndef __MR_TRS_HPP_
+#define __MR_TRS_HPP_
+
+#include "def.hpp"
+#include "vec.hpp"
+#include "matr.hpp"
+#include "quat.hpp"
+#include "transform.hpp"
+
+// translation, rotation and scale of a transformation (e.g. animation channels)
+//   mr::Matr4f m = mr::Matr4f::trs(t, q, s);   // same as scale(s) * rotation(q) * translate(t)
+//   mr::Trsf trs = m.decompose();              // m.decompose<mr::DecomposeMode::orthogonalize>() for sheared matrices
+//   mr::compose(bones, matrices);              // batch versions
+//   mr::decompose(matrices, bones);
+// rotation is a normalized quaternion: w() is the scalar part, vec() the vector part
+
+namespace mr {
+  // forward declarations (Trs<T> is declared in vec.hpp)
+
+  // common aliases
+  using Trsf = Trs<float>;
+  using Trsd = Trs<double>;
+
+  template <ArithmeticT T>
+    struct Trs {
+    public:
+      using ValueT = T;
+
+      Vec3<T> translation {};
+      Quat<T> rotation {Radians<T>(1), 0, 0, 0};
+      Vec3<T> scale {1, 1, 1};
+
+      [[nodiscard]] constexpr Matr4<T> matr() const noexcept {
+        return Matr4<T>::trs(translation, rotation, scale);
+      }
+
+      constexpr bool equal(const Trs &other, T eps = epsilon<T>()) const noexcept {
+        return translation.equal(other.translation, eps) && scale.equal(other.scale, eps) &&
+               Vec4<T>(rotation).equal(Vec4<T>(other.rotation), eps);
+      }
+
+      friend std::ostream & operator<<(std::ostream &os, const Trs &trs) noexcept {
+        os << "(t: " << trs.translation << ", r: " << Vec4<T>(trs.rotation) << ", s: " << trs.scale << ')';
+        return os;
+      }
+    };
+
+  namespace details {
+    template <typename R>
+      concept TrsRangeT = std::ranges::contiguous_range<R> &&
+        std::same_as<std::ranges::range_value_t<R>, Trs<typename std::ranges::range_value_t<R>::ValueT>>;
+  } // namespace details
+
+  // batch versions (native registers, NativeSimdImpl<T>::size() transforms per iteration)
+  template <mr::details::TrsRangeT I, mr::details::Matr4RangeT O>
+    void compose(const I &in, O &&out) noexcept {
+      using T = typename std::ranges::range_value_t<O>::ValueT;
+      using SimdT = NativeSimdImpl<T>;
+      using RowT = Row<T, 4>;
+      constexpr size_t width = SimdT::size();
+      const size_t n = std::ranges::size(in);
+      assert(std::ranges::size(out) >= n);
+      const auto *src = std::ranges::data(in);
+      auto *dst = std::ranges::data(out);
+
+      size_t i = 0;
+      for (; i + width <= n; i += width) {
+        const auto lanes = [src, i](auto &&component) {
+          return SimdT::generate([&](size_t l) { return component(src[i + l]); });
+        };
+        const auto m = mr::details::trs_compose_kernel<SimdT>(
+          {lanes([](const Trs<T> &t) { return t.rotation.x(); }), lanes([](const Trs<T> &t) { return t.rotation.y(); }),
+           lanes([](const Trs<T> &t) { return t.rotation.z(); }), lanes([](const Trs<T> &t) { return t.rotation.w(); })},
+          {lanes([](const Trs<T> &t) { return t.scale.x(); }), lanes([](const Trs<T> &t) { return t.scale.y(); }),
+           lanes([](const Trs<T> &t) { return t.scale.z(); })});
+        for (size_t l = 0; l < width; l++) {
+          const Vec3<T> &t = src[i + l].translation;
+          dst[i + l] = Matr4<T> {
+            RowT(m[0][0][l], m[0][1][l], m[0][2][l], 0),
+            RowT(m[1][0][l], m[1][1][l], m[1][2][l], 0),
+            RowT(m[2][0][l], m[2][1][l], m[2][2][l], 0),
+            RowT(t.x(), t.y(), t.z(), 1)
+          };
+        }
+      }
+      for (; i < n; i++) {
+        dst[i] = Matr4<T>::trs(src[i]);
+      }
+    }
+
+  template <DecomposeMode Mode = DecomposeMode::fast, mr::details::Matr4RangeT I, mr::details::TrsRangeT O>
+    void decompose(const I &in, O &&out) noexcept {
+      using T = typename std::ranges::range_value_t<I>::ValueT;
+      using SimdT = NativeSimdImpl<T>;
+      constexpr size_t width = SimdT::size();
+      const size_t n = std::ranges::size(in);
+      assert(std::ranges::size(out) >= n);
+      const auto *src = std::ranges::data(in);
+      auto *dst = std::ranges::data(out);
+
+      size_t i = 0;
+      for (; i + width <= n; i += width) {
+        const auto lanes = [src, i](size_t r, size_t c) {
+          return SimdT::generate([=](size_t l) { return src[i + l][r][c]; });
+        };
+        std::array<SimdT, 4> q;
+        std::array<SimdT, 3> s;
+        mr::details::trs_decompose_kernel<SimdT>({{
+          {lanes(0, 0), lanes(0, 1), lanes(0, 2)},
+          {lanes(1, 0), lanes(1, 1), lanes(1, 2)},
+          {lanes(2, 0), lanes(2, 1), lanes(2, 2)},
+        }}, Mode == DecomposeMode::orthogonalize, q, s);
+        for (size_t l = 0; l < width; l++) {
+          const Matr4<T> &m = src[i + l];
+          dst[i + l] = {
+            Vec3<T>(m[3][0], m[3][1], m[3][2]),
+            Quat<T>(Radians<T>(q[3][l]), q[0][l], q[1][l], q[2][l]),
+            Vec3<T>(s[0][l], s[1][l], s[2][l])
+          };
+        }
+      }
+      for (; i < n; i++) {
+        dst[i] = src[i].template decompose<Mode>();
+      }
+    }
+} // namespace mr
+
+#endif // __MR_TRS_HPP_
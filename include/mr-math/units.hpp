@@ -51,8 +51,8 @@ namespace mr {
 
       T _data {};
 
-      constexpr Radians() noexcept {};
-      explicit constexpr Radians(T x) noexcept : _data(x) {};
+      constexpr Radians() noexcept {}
+      explicit constexpr Radians(T x) noexcept : _data(x) {}
 
       template <typename U>
         constexpr Radians(const Radians<U> &other) noexcept : _data(other._data) {}
@@ -63,7 +63,7 @@ namespace mr {
           return Degrees<U>{static_cast<U>(_data) *
             std::numbers::inv_pi_v<U> * static_cast<U>(180.)};
         }
-      explicit constexpr operator T() const noexcept { return _data; };
+      explicit constexpr operator T() const noexcept { return _data; }
 
       // comparison operator
       [[nodiscard]] friend constexpr auto operator<=>(Radians lhs, Radians rhs) = default;
@@ -81,7 +81,7 @@ namespace mr {
 
       T _data {};
 
-      explicit constexpr Degrees(T x) noexcept : _data(x) {};
+      explicit constexpr Degrees(T x) noexcept : _data(x) {}
 
       template <typename U>
         constexpr Degrees(const Degrees<U> &other) noexcept
@@ -93,7 +93,7 @@ namespace mr {
           return Radians<U>{static_cast<U>(_data) / static_cast<U>(180.) * std::numbers::pi_v<U>};
         }
 
-      explicit constexpr operator T() const noexcept { return _data; };
+      explicit constexpr operator T() const noexcept { return _data; }
 
       // comparison operator
       [[nodiscard]] friend constexpr auto operator<=>(Degrees lhs, Degrees rhs) = default;
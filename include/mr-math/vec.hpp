@@ -3,6 +3,7 @@
 
 #include "def.hpp"
 #include "row.hpp"
+#include "rsqrt.hpp"
 
 namespace mr {
   // forward declarations
@@ -10,10 +11,12 @@ namespace mr {
     struct Vec;
   template <ArithmeticT T, std::size_t N> requires (N >= 2)
     struct Norm;
-  template <ArithmeticT T, std::size_t N>
+  template <ArithmeticT T, std::size_t R, std::size_t C = R>
     struct Matr;
   template <ArithmeticT T>
     struct Quat;
+  template <ArithmeticT T>
+    struct Trs;
 
   // common aliases
   template <ArithmeticT T>
@@ -56,17 +59,27 @@ namespace mr {
       constexpr Vec() noexcept = default;
 
       // from simd constructor
-      constexpr Vec(const RowT &row) noexcept : _data(row._data) {};
+      constexpr Vec(const RowT &row) noexcept : _data(row._data) {}
 
       // from elements constructor
       template <ArithmeticT... Args>
       requires (sizeof...(Args) >= 2) && (sizeof...(Args) <= N)
         constexpr Vec(Args... args) : _data(args...) {}
 
+      // from memory constructor (reads N elements)
+      template <typename Flags>
+        constexpr Vec(const T *data, Flags flags) noexcept : _data(data, flags) {}
+
       // from span constructor
-      // TODO: implement using Vc
+      // missing components are zeroed
       template <ArithmeticT U, size_t M>
         constexpr Vec(std::span<const U, M> span) noexcept {
+          if constexpr (std::same_as<T, U>) {
+            if (span.size() >= N) {
+              _data = RowT(span.data(), unaligned);
+              return;
+            }
+          }
           const size_t len = std::min(N, span.size());
           for (size_t i = 0; i < len; i++) {
             _data._set_ind(i, span[i]);
@@ -83,6 +96,43 @@ namespace mr {
         constexpr Vec(const Vec<R, S> &v, Args ... args) noexcept : _data(v, args...) {}
 #endif
 
+      // load/store methods (see mr::aligned, mr::unaligned, mr::streaming)
+      [[nodiscard]] static constexpr Vec load(const T *data) noexcept {
+        return RowT::load(data);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Vec load(const T *data, Flags flags) noexcept {
+          return RowT::load(data, flags);
+        }
+
+      [[nodiscard]] static constexpr Vec load(std::span<const T> data) noexcept {
+        return RowT::load(data);
+      }
+
+      template <typename Flags>
+        [[nodiscard]] static constexpr Vec load(std::span<const T> data, Flags flags) noexcept {
+          return RowT::load(data, flags);
+        }
+
+      constexpr void store(T *data) const noexcept {
+        _data.store(data);
+      }
+
+      template <typename Flags>
+        constexpr void store(T *data, Flags flags) const noexcept {
+          _data.store(data, flags);
+        }
+
+      constexpr void store(std::span<T> data) const noexcept {
+        _data.store(data);
+      }
+
+      template <typename Flags>
+        constexpr void store(std::span<T> data, Flags flags) const noexcept {
+          _data.store(data, flags);
+        }
+
       // setters
       constexpr void set(size_t i, T value) noexcept { _data._set_ind(i, value); } // for some reason `T & RowT::operator[]` doesn't compile (maybe I'm just stupid)
       constexpr void x(T x) noexcept requires (N >= 1) { set(0, x); }
@@ -100,6 +150,33 @@ namespace mr {
       // structured binding support
       template <size_t I> requires (I < N) constexpr T get() const { return _data[I]; }
 
+      // swizzle
+      // v.swizzle<2, 1, 0>() == Vec3(v.z(), v.y(), v.x())
+      template <size_t ...I> requires (sizeof...(I) >= 2) && ((I < N) && ...)
+        [[nodiscard]] constexpr Vec<T, sizeof...(I)> swizzle() const noexcept {
+          return typename Vec<T, sizeof...(I)>::RowT(mr::details::swizzle_simd<I...>(*this));
+        }
+
+      [[nodiscard]] constexpr Vec<T, 2> xy() const noexcept { return swizzle<0, 1>(); }
+      [[nodiscard]] constexpr Vec<T, 2> yx() const noexcept { return swizzle<1, 0>(); }
+      [[nodiscard]] constexpr Vec<T, 2> xz() const noexcept requires (N >= 3) { return swizzle<0, 2>(); }
+      [[nodiscard]] constexpr Vec<T, 2> zx() const noexcept requires (N >= 3) { return swizzle<2, 0>(); }
+      [[nodiscard]] constexpr Vec<T, 2> yz() const noexcept requires (N >= 3) { return swizzle<1, 2>(); }
+      [[nodiscard]] constexpr Vec<T, 2> zy() const noexcept requires (N >= 3) { return swizzle<2, 1>(); }
+
+      [[nodiscard]] constexpr Vec<T, 3> xyz() const noexcept requires (N >= 3) { return swizzle<0, 1, 2>(); }
+      [[nodiscard]] constexpr Vec<T, 3> xzy() const noexcept requires (N >= 3) { return swizzle<0, 2, 1>(); }
+      [[nodiscard]] constexpr Vec<T, 3> yxz() const noexcept requires (N >= 3) { return swizzle<1, 0, 2>(); }
+      [[nodiscard]] constexpr Vec<T, 3> yzx() const noexcept requires (N >= 3) { return swizzle<1, 2, 0>(); }
+      [[nodiscard]] constexpr Vec<T, 3> zxy() const noexcept requires (N >= 3) { return swizzle<2, 0, 1>(); }
+      [[nodiscard]] constexpr Vec<T, 3> zyx() const noexcept requires (N >= 3) { return swizzle<2, 1, 0>(); }
+
+      [[nodiscard]] constexpr Vec<T, 4> wzyx() const noexcept requires (N >= 4) { return swizzle<3, 2, 1, 0>(); }
+      [[nodiscard]] constexpr Vec<T, 4> xxxx() const noexcept { return swizzle<0, 0, 0, 0>(); }
+      [[nodiscard]] constexpr Vec<T, 4> yyyy() const noexcept { return swizzle<1, 1, 1, 1>(); }
+      [[nodiscard]] constexpr Vec<T, 4> zzzz() const noexcept requires (N >= 3) { return swizzle<2, 2, 2, 2>(); }
+      [[nodiscard]] constexpr Vec<T, 4> wwww() const noexcept requires (N >= 4) { return swizzle<3, 3, 3, 3>(); }
+
       // cross product
       constexpr Vec cross(const Vec &other) const noexcept requires (N == 3) {
         return RowT(_data._data.rotated(1) * other._data._data.rotated(-1)
@@ -131,63 +208,63 @@ namespace mr {
         return std::sqrt(length2());
       }
 
-      // use 1 / length() for higher precision
-      [[nodiscard]] constexpr T inversed_length() const {
-        return fast_rsqrt(length2());
-      }
+      // use 1 / length() for higher precision (see RsqrtPrecision)
+      template <RsqrtPrecision P = RsqrtPrecision::newton1>
+        [[nodiscard]] constexpr T inversed_length() const {
+          return rsqrt<P>(length2());
+        }
 
       // normalize methods
-      constexpr Vec & normalize() noexcept {
-        auto len = length2();
-        if (len <= _epsilon) [[unlikely]] return *this;
-        *this /= std::sqrt(len);
-        return *this;
-      };
-
-      constexpr std::optional<NormT> normalized() const noexcept {
-        auto len = length2();
-        if (len <= _epsilon) [[unlikely]] return std::nullopt;
-        return {{*this / std::sqrt(len)}};
-      };
-
-      constexpr Vec & normalize_unchecked() noexcept {
-        auto len = length2();
-        *this /= std::sqrt(len);
-        return *this;
-      };
-
-      constexpr NormT normalized_unchecked() const noexcept {
-        auto len = length2();
-        return {*this / std::sqrt(len)};
-      };
+      // precision can be traded for throughput with RsqrtPrecision
+      template <RsqrtPrecision P = RsqrtPrecision::exact>
+        constexpr Vec & normalize() noexcept {
+          auto len = length2();
+          if (len <= _epsilon) [[unlikely]] return *this;
+          *this = _scaled<P>(len);
+          return *this;
+        }
+
+      template <RsqrtPrecision P = RsqrtPrecision::exact>
+        constexpr std::optional<NormT> normalized() const noexcept {
+          auto len = length2();
+          if (len <= _epsilon) [[unlikely]] return std::nullopt;
+          return {{_scaled<P>(len)}};
+        }
+
+      template <RsqrtPrecision P = RsqrtPrecision::exact>
+        constexpr Vec & normalize_unchecked() noexcept {
+          *this = _scaled<P>(length2());
+          return *this;
+        }
+
+      template <RsqrtPrecision P = RsqrtPrecision::exact>
+        constexpr NormT normalized_unchecked() const noexcept {
+          return {_scaled<P>(length2())};
+        }
 
       // use normalize() for higher precision
-      constexpr Vec & normalize_fast() noexcept {
-        auto len = length2();
-        if (len <= _epsilon) [[unlikely]] return *this;
-        *this *= fast_rsqrt(len);
-        return *this;
-      };
+      template <RsqrtPrecision P = RsqrtPrecision::newton1>
+        constexpr Vec & normalize_fast() noexcept {
+          return normalize<P>();
+        }
 
       // use normalized() for higher precision
-      constexpr std::optional<NormT> normalized_fast() const noexcept {
-        auto len = length2();
-        if (len <= _epsilon) [[unlikely]] return std::nullopt;
-        return {{*this * fast_rsqrt(len)}};
-      };
+      template <RsqrtPrecision P = RsqrtPrecision::newton1>
+        constexpr std::optional<NormT> normalized_fast() const noexcept {
+          return normalized<P>();
+        }
 
       // use normalize_unchecked() for higher precision
-      constexpr Vec & normalize_fast_unchecked() {
-        auto l = length2();
-        *this *= fast_rsqrt(l);
-        return *this;
-      };
+      template <RsqrtPrecision P = RsqrtPrecision::newton1>
+        constexpr Vec & normalize_fast_unchecked() {
+          return normalize_unchecked<P>();
+        }
 
       // use normalized_unchecked() for higher precision
-      constexpr NormT normalized_fast_unchecked() const {
-        auto l = length2();
-        return {*this * fast_rsqrt(l)};
-      };
+      template <RsqrtPrecision P = RsqrtPrecision::newton1>
+        constexpr NormT normalized_fast_unchecked() const {
+          return normalized_unchecked<P>();
+        }
 
       // dot product
       [[nodiscard]] constexpr T dot(const Vec &other) const noexcept {
@@ -201,9 +278,9 @@ namespace mr {
       template<ArithmeticT R>
         constexpr Vec operator*(const Matr<R, N> &other) const noexcept {
           Vec res {};
-          for (size_t i = 0; i < N; i++) {
-            res._data += (other._data[i] * _data[i])._data;
-          }
+          [&]<std::size_t ...I>(std::index_sequence<I...>) {
+            ((res._data += (other._data[I] * _data[I])._data), ...);
+          }(std::make_index_sequence<N>{});
           return res;
         }
 
@@ -212,9 +289,9 @@ namespace mr {
           Vec<T, N + 1> copy = Vec<T, N + 1>(*this);
           Vec<T, N + 1> tmp {};
 
-          for (size_t i = 0; i < N; i++) {
-            tmp._data += (other._data[i] * copy._data[i])._data;
-          }
+          [&]<std::size_t ...I>(std::index_sequence<I...>) {
+            ((tmp._data += (other._data[I] * copy._data[I])._data), ...);
+          }(std::make_index_sequence<N>{});
           tmp._data += other._data[N]._data;
           return {tmp};
         }
@@ -222,9 +299,9 @@ namespace mr {
       template<ArithmeticT R>
         constexpr Vec & operator*=(const Matr<R, N> &other) noexcept {
           Vec tmp {};
-          for (size_t i = 0; i < N; i++) {
-            tmp._data += (other._data[i] * _data[i])._data;
-          }
+          [&]<std::size_t ...I>(std::index_sequence<I...>) {
+            ((tmp._data += (other._data[I] * _data[I])._data), ...);
+          }(std::make_index_sequence<N>{});
           *this = tmp;
           return *this;
         }
@@ -233,9 +310,9 @@ namespace mr {
         constexpr Vec & operator*=(const Matr<R, N + 1> &other) noexcept {
           Vec<T, N + 1> copy = Vec<T, N + 1>(*this);
           Vec<T, N + 1> tmp {};
-          for (size_t i = 0; i < N; i++) {
-            tmp._data += (other._data[i] * copy._data[i])._data;
-          }
+          [&]<std::size_t ...I>(std::index_sequence<I...>) {
+            ((tmp._data += (other._data[I] * copy._data[I])._data), ...);
+          }(std::make_index_sequence<N>{});
           tmp._data += other._data[N]._data;
 
           *this = Vec<T, N>(tmp);
@@ -281,6 +358,16 @@ namespace mr {
         }
 
       private:
+        // *this / sqrt(len2)
+        template <RsqrtPrecision P>
+          constexpr Vec _scaled(T len2) const noexcept {
+            if constexpr (P == RsqrtPrecision::exact) {
+              return *this / std::sqrt(len2);
+            } else {
+              return *this * rsqrt<P>(len2);
+            }
+          }
+
         static constexpr T _epsilon = std::numeric_limits<T>::epsilon();
     };
 } // namespace mr
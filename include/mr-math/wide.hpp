@@ -0,0 +1,190 @@
+#ifndef __MR_WIDE_HPP_
+#define __MR_WIDE_HPP_
+
+#include "def.hpp"
+#include "dispatch.hpp"
+
+// 4x4 matrix kernels for wide registers (row-major float[16]/double[16] in and out)
+//   avx2:   two float rows per __m256, one double row per __m256d
+//   avx512: whole float matrix per __m512, two double rows per __m512d (multiply only)
+// only batch functions (mr::multiply, mr::transpose) use them, picking the widest kernels at runtime
+// through mr::active_isa(); single Matr4 operators stay on 128 bit rows, since moving one matrix
+// between rows and a wide register costs more than the product itself
+
+namespace mr {
+  namespace details {
+#if MR_MATH_RUNTIME_DISPATCH
+    // out = a * b
+    [[gnu::target("avx2,fma"), gnu::always_inline]]
+      inline void mul4x4_avx2(const float *a, const float *b, float *out) noexcept {
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 0));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+        for (size_t i = 0; i < 16; i += 8) {
+          // rows i / 4 and i / 4 + 1, elements are broadcast within 128 bit lanes
+          const __m256 rows = _mm256_loadu_ps(a + i);
+          __m256 res = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b0);
+          res = _mm256_fmadd_ps(_mm256_permute_ps(rows, 0x55), b1, res);
+          res = _mm256_fmadd_ps(_mm256_permute_ps(rows, 0xAA), b2, res);
+          res = _mm256_fmadd_ps(_mm256_permute_ps(rows, 0xFF), b3, res);
+          _mm256_storeu_ps(out + i, res);
+        }
+      }
+
+    [[gnu::target("avx2,fma"), gnu::always_inline]]
+      inline void mul4x4_avx2(const double *a, const double *b, double *out) noexcept {
+        const __m256d b0 = _mm256_loadu_pd(b + 0);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        const __m256d b2 = _mm256_loadu_pd(b + 8);
+        const __m256d b3 = _mm256_loadu_pd(b + 12);
+        for (size_t i = 0; i < 16; i += 4) {
+          __m256d res = _mm256_mul_pd(_mm256_broadcast_sd(a + i + 0), b0);
+          res = _mm256_fmadd_pd(_mm256_broadcast_sd(a + i + 1), b1, res);
+          res = _mm256_fmadd_pd(_mm256_broadcast_sd(a + i + 2), b2, res);
+          res = _mm256_fmadd_pd(_mm256_broadcast_sd(a + i + 3), b3, res);
+          _mm256_storeu_pd(out + i, res);
+        }
+      }
+
+    // gcc 12 reports the self initialized _mm512_undefined_* used by the avx512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    [[gnu::target("avx512f,avx2,fma"), gnu::always_inline]]
+      inline void mul4x4_avx512(const float *a, const float *b, float *out) noexcept {
+        const __m512 rows = _mm512_loadu_ps(a);
+        __m512 res = _mm512_mul_ps(_mm512_permute_ps(rows, 0x00), _mm512_broadcast_f32x4(_mm_loadu_ps(b + 0)));
+        res = _mm512_fmadd_ps(_mm512_permute_ps(rows, 0x55), _mm512_broadcast_f32x4(_mm_loadu_ps(b + 4)), res);
+        res = _mm512_fmadd_ps(_mm512_permute_ps(rows, 0xAA), _mm512_broadcast_f32x4(_mm_loadu_ps(b + 8)), res);
+        res = _mm512_fmadd_ps(_mm512_permute_ps(rows, 0xFF), _mm512_broadcast_f32x4(_mm_loadu_ps(b + 12)), res);
+        _mm512_storeu_ps(out, res);
+      }
+
+    [[gnu::target("avx512f,avx2,fma"), gnu::always_inline]]
+      inline void mul4x4_avx512(const double *a, const double *b, double *out) noexcept {
+        const __m512d b0 = _mm512_broadcast_f64x4(_mm256_loadu_pd(b + 0));
+        const __m512d b1 = _mm512_broadcast_f64x4(_mm256_loadu_pd(b + 4));
+        const __m512d b2 = _mm512_broadcast_f64x4(_mm256_loadu_pd(b + 8));
+        const __m512d b3 = _mm512_broadcast_f64x4(_mm256_loadu_pd(b + 12));
+        for (size_t i = 0; i < 16; i += 8) {
+          // rows i / 4 and i / 4 + 1, elements are broadcast within 256 bit lanes
+          const __m512d rows = _mm512_loadu_pd(a + i);
+          __m512d res = _mm512_mul_pd(_mm512_permutex_pd(rows, 0x00), b0);
+          res = _mm512_fmadd_pd(_mm512_permutex_pd(rows, 0x55), b1, res);
+          res = _mm512_fmadd_pd(_mm512_permutex_pd(rows, 0xAA), b2, res);
+          res = _mm512_fmadd_pd(_mm512_permutex_pd(rows, 0xFF), b3, res);
+          _mm512_storeu_pd(out + i, res);
+        }
+      }
+
+    [[gnu::target("avx2,fma"), gnu::always_inline]]
+      inline void transpose4x4_avx2(const double *m, double *out) noexcept {
+        const __m256d r0 = _mm256_loadu_pd(m + 0), r1 = _mm256_loadu_pd(m + 4);
+        const __m256d r2 = _mm256_loadu_pd(m + 8), r3 = _mm256_loadu_pd(m + 12);
+        const __m256d lo01 = _mm256_unpacklo_pd(r0, r1), hi01 = _mm256_unpackhi_pd(r0, r1);
+        const __m256d lo23 = _mm256_unpacklo_pd(r2, r3), hi23 = _mm256_unpackhi_pd(r2, r3);
+        _mm256_storeu_pd(out + 0, _mm256_permute2f128_pd(lo01, lo23, 0x20));
+        _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(hi01, hi23, 0x20));
+        _mm256_storeu_pd(out + 8, _mm256_permute2f128_pd(lo01, lo23, 0x31));
+        _mm256_storeu_pd(out + 12, _mm256_permute2f128_pd(hi01, hi23, 0x31));
+      }
+
+    // whole matrix in one register, a single cross lane permute
+    [[gnu::target("avx512f,avx2,fma"), gnu::always_inline]]
+      inline void transpose4x4_avx512(const float *m, float *out) noexcept {
+        const __m512i columns = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+        _mm512_storeu_ps(out, _mm512_permutexvar_ps(columns, _mm512_loadu_ps(m)));
+      }
+
+    // out[i] = transposed in[i] for 'count' matrices
+    [[gnu::target("avx512f,avx2,fma")]]
+      inline void transpose4x4_batch_avx512(const float *in, float *out, std::size_t count) noexcept {
+        for (size_t i = 0; i < count; i++) {
+          transpose4x4_avx512(in + 16 * i, out + 16 * i);
+        }
+      }
+
+    [[gnu::target("avx2,fma")]]
+      inline void transpose4x4_batch_avx2(const double *in, double *out, std::size_t count) noexcept {
+        for (size_t i = 0; i < count; i++) {
+          transpose4x4_avx2(in + 16 * i, out + 16 * i);
+        }
+      }
+
+    // out[i] = a[i * a_stride] * b[i * b_stride] for 'count' matrices (stride 0 shares a matrix)
+    // inputs are prefetched 'distance' matrices ahead
+    template <typename T> [[gnu::target("avx2,fma")]]
+      void mul4x4_batch_avx2(const T *a, std::size_t a_stride, const T *b, std::size_t b_stride,
+                             T *out, std::size_t count, std::size_t distance) noexcept {
+        for (size_t i = 0; i < count; i++) {
+          if (i + distance < count) {
+            __builtin_prefetch(a + (i + distance) * a_stride);
+            __builtin_prefetch(b + (i + distance) * b_stride);
+          }
+          mul4x4_avx2(a + i * a_stride, b + i * b_stride, out + 16 * i);
+        }
+      }
+
+    template <typename T> [[gnu::target("avx512f,avx2,fma")]]
+      void mul4x4_batch_avx512(const T *a, std::size_t a_stride, const T *b, std::size_t b_stride,
+                               T *out, std::size_t count, std::size_t distance) noexcept {
+        for (size_t i = 0; i < count; i++) {
+          if (i + distance < count) {
+            __builtin_prefetch(a + (i + distance) * a_stride);
+            __builtin_prefetch(b + (i + distance) * b_stride);
+          }
+          mul4x4_avx512(a + i * a_stride, b + i * b_stride, out + 16 * i);
+        }
+      }
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic pop
+#endif
+#endif
+
+    // batched 4x4 multiply on the widest registers allowed by mr::active_isa()
+    // returns false (and does nothing) if only 128 bit registers are available
+    template <typename T>
+      bool mul4x4_batch(const T *a, std::size_t a_stride, const T *b, std::size_t b_stride,
+                        T *out, std::size_t count, std::size_t distance) noexcept {
+#if MR_MATH_RUNTIME_DISPATCH
+        switch (active_isa()) {
+          case Isa::avx512:
+            mul4x4_batch_avx512(a, a_stride, b, b_stride, out, count, distance);
+            return true;
+          case Isa::avx2:
+            mul4x4_batch_avx2(a, a_stride, b, b_stride, out, count, distance);
+            return true;
+          default:
+            return false;
+        }
+#else
+        return false;
+#endif
+      }
+
+    // batched 4x4 transpose, returns false (and does nothing) if no wide kernel fits mr::active_isa()
+    template <typename T>
+      bool transpose4x4_batch(const T *in, T *out, std::size_t count) noexcept {
+#if MR_MATH_RUNTIME_DISPATCH
+        if constexpr (std::same_as<T, float>) {
+          // below avx512 float rows already fit 128 bit registers (see transpose4_simd)
+          if (active_isa() == Isa::avx512) {
+            transpose4x4_batch_avx512(in, out, count);
+            return true;
+          }
+        } else {
+          // two cross lane permutes per matrix on __m512d measured slower than this on avx512 hosts
+          if (active_isa() >= Isa::avx2) {
+            transpose4x4_batch_avx2(in, out, count);
+            return true;
+          }
+        }
+#endif
+        return false;
+      }
+  } // namespace details
+} // namespace mr
+
+#endif // __MR_WIDE_HPP_
@@ -25,6 +25,20 @@ TEST_F(Vector3DTest, Constructors) {
   EXPECT_EQ(mr::Vec3f(std::span<const int>{{1, 2, 3}}), mr::Vec3f(1, 2, 3));
 }
 
+TEST_F(Vector3DTest, LoadStore) {
+  alignas(64) std::array<float, 8> src {1, 2, 3, 4, 5, 6, 7, 8};
+  EXPECT_EQ(mr::Vec3f::load(src.data()), mr::Vec3f(1, 2, 3));
+  EXPECT_EQ(mr::Vec3f::load(src.data() + 1), mr::Vec3f(2, 3, 4));
+  EXPECT_EQ(mr::Vec3f::load(src.data(), mr::aligned), mr::Vec3f(1, 2, 3));
+  EXPECT_EQ(mr::Vec4f::load(src, mr::aligned), mr::Vec4f(1, 2, 3, 4));
+  EXPECT_EQ(mr::Vec3f(src.data() + 4, mr::unaligned), mr::Vec3f(5, 6, 7));
+
+  alignas(64) std::array<float, 8> dst {};
+  v1.store(dst.data() + 1);
+  mr::Vec4f(5, 6, 7, 8).store(dst.data() + 4, mr::streaming);
+  EXPECT_EQ(dst, (std::array<float, 8>{0, 1, 2, 3, 5, 6, 7, 8}));
+}
+
 TEST_F(Vector3DTest, Getters) {
   EXPECT_EQ(v1.x(), 1.0);
   EXPECT_EQ(v1.y(), 2.0);
@@ -99,6 +113,49 @@ TEST_F(Vector3DTest, Normalize) {
   EXPECT_EQ(zero_v.normalize(), zero_v);
   auto null = zero_v.normalized();
   EXPECT_FALSE(null.has_value());
+
+  using enum mr::RsqrtPrecision;
+  EXPECT_TRUE(mr::equal(v1.normalized_fast_unchecked<newton2>(), expected, 0.00001));
+  EXPECT_TRUE(mr::equal(v1.normalized_unchecked<newton1>(), expected, 0.002));
+  EXPECT_TRUE(v1.normalized<estimate>().has_value());
+}
+
+TEST_F(Vector3DTest, Rsqrt) {
+  using enum mr::RsqrtPrecision;
+  auto rel_error = [](float approx, float x) { return std::abs(approx * std::sqrt(x) - 1); };
+
+  // scalar versions
+  for (float x : {0.001f, 0.5f, 1.f, 2.f, 14.f, 12345.f}) {
+    EXPECT_LT(rel_error(mr::rsqrt<estimate>(x), x), 0.04);
+#if defined(__SSE__)
+    // hardware estimate (rsqrtss) at run time
+    EXPECT_LT(rel_error(mr::rsqrt<estimate>(x), x), 0.0005);
+    EXPECT_LT(std::abs(mr::rsqrt<estimate>(double(x)) * std::sqrt(double(x)) - 1), 0.0005);
+#endif
+    EXPECT_LT(rel_error(mr::rsqrt<newton1>(x), x), 0.002);
+    EXPECT_LT(rel_error(mr::rsqrt<newton2>(x), x), 0.00001);
+    EXPECT_FLOAT_EQ(mr::rsqrt<exact>(x), 1 / std::sqrt(x));
+  }
+  EXPECT_NEAR(v1.inversed_length<newton2>(), 1 / std::sqrt(14.0f), 0.00001);
+  static_assert(mr::rsqrt<newton2>(4.f) > 0.49f && mr::rsqrt<newton2>(4.f) < 0.51f);
+
+  // simd and batch versions (covers native width and the tail)
+  std::vector<float> in(19), out(19);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = 0.25f + 3.f * i;
+  }
+  const auto simd = mr::rsqrt<newton2>(mr::SimdImpl<float, 4>([&in](size_t i) { return in[i]; }));
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_LT(rel_error(simd[i], in[i]), 0.00001);
+  }
+  mr::rsqrt<newton1>(in, out);
+  for (size_t i = 0; i < in.size(); i++) {
+    EXPECT_LT(rel_error(out[i], in[i]), 0.002);
+  }
+  mr::rsqrt<exact>(in, out);
+  for (size_t i = 0; i < in.size(); i++) {
+    EXPECT_FLOAT_EQ(out[i], 1 / std::sqrt(in[i]));
+  }
 }
 
 TEST_F(Vector3DTest, Abs) {
@@ -113,6 +170,408 @@ TEST_F(Vector3DTest, Clamp) {
   EXPECT_EQ(v.clamp(-47, 0), mr::Vec3f(-30, 0, -47));
 }
 
+TEST_F(Vector3DTest, PackedPadded) {
+  mr::Vec3fPacked packed = v1;
+  EXPECT_EQ(packed, mr::Vec3fPacked(1, 2, 3));
+  EXPECT_EQ(mr::Vec3f(packed), v1);
+
+  std::array<mr::Vec3fPacked, 2> vertices {v1, v2};
+  EXPECT_EQ(reinterpret_cast<const float *>(vertices.data())[3], 4);
+
+  mr::Vec3fPadded p1 = v1, p2 = packed;
+  mr::Vec3fPadded p3 = v2;
+  EXPECT_EQ(p1, p2);
+  EXPECT_EQ(mr::Vec3f(p1 + p3), v1 + v2);
+  EXPECT_EQ(mr::Vec3f(p1 - p3 * 2), v1 - v2 * 2);
+  EXPECT_EQ(mr::Vec3f(p1.cross(p3)), v1.cross(v2));
+  EXPECT_EQ(p1.dot(p3), v1.dot(v2));
+  EXPECT_EQ(p1.length2(), v1.length2());
+  EXPECT_TRUE(mr::equal(mr::Vec3f(p1.normalize()), v1.normalized_unchecked(), 0.000001));
+}
+
+TEST_F(Vector3DTest, LazyExpression) {
+  const mr::Vec3f v3{-1, 0.5, 2};
+  const mr::Vec3f expected = v1 * v2 + v3 * v1 - v2;
+
+  mr::Vec3f res = mr::lazy(v1) * v2 + mr::lazy(v3) * v1 - v2;
+  EXPECT_EQ(res, expected);
+  // every product of the chain is folded into the sum: fma(v1, v2, fma(v3, v1, -v2))
+  EXPECT_EQ(res, mr::fma(v1, v2, mr::fma(v3, v1, -v2)));
+  EXPECT_EQ(mr::eval(v1 - (mr::lazy(v2) * v3 - v1 * v2)), mr::fma(-v2, v3, v1) + v1 * v2);
+  EXPECT_EQ(mr::eval(v2 - mr::lazy(v1) * v3), v2 - v1 * v3);
+  EXPECT_EQ(mr::eval(2 * mr::lazy(v1) + 1.f), v1 * 2 + 1);
+  EXPECT_EQ(mr::eval(-mr::lazy(v1) / v2), -v1 / v2);
+
+  mr::Row<float, 4> r {1, 2, 3, 4};
+  mr::Row<float, 4> rres = mr::lazy(r) * r - r;
+  EXPECT_EQ(rres, (mr::Row<float, 4>{0, 2, 6, 12}));
+
+  // (1 + 2^-12)^2 = 1 + 2^-11 + 2^-24 is rounded to 1 + 2^-11 by a separate multiply,
+  // the fused path keeps the 2^-24
+  const float e = std::ldexp(1.f, -12);
+  const mr::Vec3f a(1 + e), c(-(1 + 2 * e));
+  const mr::Vec3f fused = mr::lazy(a) * a + c;
+#ifdef __FMA__
+  EXPECT_EQ(fused, mr::Vec3f(e * e));
+#else
+  EXPECT_EQ(fused, mr::Vec3f(0));
+#endif
+}
+
+TEST_F(Vector3DTest, Functions) {
+  EXPECT_EQ(mr::fma(v1, v2, v1), v1 * v2 + v1);
+  EXPECT_EQ(mr::lerp(v1, v2, 0.5f), mr::Vec3f(2.5, 3.5, 4.5));
+  EXPECT_EQ(mr::mix(v1, v2, mr::Vec3f(0, 1, 0.5)), mr::Vec3f(1, 5, 4.5));
+  EXPECT_EQ(mr::min(mr::Vec3f(1, 5, 3), mr::Vec3f(2, 4, 3)), mr::Vec3f(1, 4, 3));
+  EXPECT_EQ(mr::max(mr::Vec3f(1, 5, 3), mr::Vec3f(2, 4, 3)), mr::Vec3f(2, 5, 3));
+  EXPECT_EQ(mr::saturate(mr::Vec3f(-1, 0.5, 2)), mr::Vec3f(0, 0.5, 1));
+  EXPECT_EQ(mr::step(2.f, v1), mr::Vec3f(0, 1, 1));
+  EXPECT_EQ(mr::smoothstep(1.f, 3.f, v1), mr::Vec3f(0, 0.5, 1));
+}
+
+TEST_F(Vector3DTest, FunctionsBatch) {
+  std::vector<mr::Vec3f> a {v1, v2, v1};
+  std::vector<mr::Vec3f> b {v2, v1, v1};
+  std::vector<mr::Vec3f> out(3);
+  mr::lerp(a, b, 0.25f, out);
+  for (size_t i = 0; i < out.size(); i++) {
+    EXPECT_EQ(out[i], mr::lerp(a[i], b[i], 0.25f));
+  }
+  mr::fma(a, b, a, out);
+  for (size_t i = 0; i < out.size(); i++) {
+    EXPECT_EQ(out[i], a[i] * b[i] + a[i]);
+  }
+
+  // scalar arrays (covers native width and the tail)
+  std::vector<float> fa(37), fb(37), fout(37);
+  for (size_t i = 0; i < fa.size(); i++) {
+    fa[i] = i;
+    fb[i] = 2.f * i;
+  }
+  mr::mix(fa, fb, 0.5f, fout);
+  for (size_t i = 0; i < fout.size(); i++) {
+    EXPECT_EQ(fout[i], 1.5f * i);
+  }
+  mr::smoothstep(0.f, 36.f, fa, fout);
+  EXPECT_EQ(fout[0], 0);
+  EXPECT_EQ(fout[18], 0.5f);
+  EXPECT_EQ(fout[36], 1);
+  mr::min(fa, fb, fout);
+  EXPECT_EQ(fout, fa);
+}
+
+TEST_F(Vector3DTest, Swizzle) {
+  EXPECT_EQ((v1.swizzle<2, 1, 0>()), mr::Vec3f(3, 2, 1));
+  EXPECT_EQ(v1.zyx(), mr::Vec3f(3, 2, 1));
+  EXPECT_EQ(v1.xzy(), mr::Vec3f(1, 3, 2));
+  EXPECT_EQ(v1.yz(), mr::Vec2f(2, 3));
+  EXPECT_EQ(v1.xxxx(), mr::Vec4f(1));
+  EXPECT_EQ((v1.swizzle<0, 0, 1, 1>()), mr::Vec4f(1, 1, 2, 2));
+
+  const mr::Vec4f v4 {1, 2, 3, 4};
+  EXPECT_EQ(v4.xyz(), v1);
+  EXPECT_EQ(v4.wzyx(), mr::Vec4f(4, 3, 2, 1));
+  EXPECT_EQ(v4.wwww(), mr::Vec4f(4));
+
+  // batch version
+  std::vector<mr::Vec4f> in {v4, v4.wzyx(), v4.xxxx()};
+  std::vector<mr::Vec3f> out(in.size());
+  mr::swizzle<2, 1, 0>(in, out);
+  for (size_t i = 0; i < in.size(); i++) {
+    EXPECT_EQ(out[i], in[i].zyx());
+  }
+}
+
+TEST_F(Vector3DTest, Half) {
+  EXPECT_EQ(mr::Half(1.f).bits(), 0x3C00);
+  EXPECT_EQ(mr::Half(-2.f).bits(), 0xC000);
+  EXPECT_EQ(mr::Half(0.1f).bits(), 0x2E66);
+  EXPECT_EQ(mr::Half(65504.f).bits(), 0x7BFF);
+  EXPECT_EQ(mr::Half(65520.f).bits(), 0x7C00); // rounds to infinity
+  EXPECT_EQ(mr::Half(std::ldexp(1.f, -24)).bits(), 0x0001);
+  EXPECT_EQ(mr::Half(std::ldexp(1.f, -26)).bits(), 0x0000);
+  EXPECT_TRUE(std::isnan(float(mr::Half(NAN))));
+  EXPECT_EQ(float(mr::Half::from_bits(0xFC00)), -INFINITY);
+
+  // every finite half survives the round trip
+  for (uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+    const auto h = mr::Half::from_bits(bits);
+    if (!std::isnan(float(h))) {
+      EXPECT_EQ(mr::Half(float(h)), h);
+    }
+  }
+
+  mr::Vec3h hv = v1;
+  EXPECT_EQ(sizeof(hv), 6);
+  EXPECT_EQ(mr::Vec3f(hv), v1);
+  const mr::Vec4h hc = mr::Color(0.25, 0.5, 1.0);
+  EXPECT_EQ(mr::Color(hc), mr::Color(0.25, 0.5, 1.0));
+}
+
+TEST_F(Vector3DTest, HalfBatch) {
+  std::vector<float> floats(37);
+  for (size_t i = 0; i < floats.size(); i++) {
+    floats[i] = (i - 18.f) * 0.37f;
+  }
+  std::vector<mr::Vec3f> vecs(19);
+  for (size_t i = 0; i < vecs.size(); i++) {
+    vecs[i] = mr::Vec3f(i, -0.5f * i, 1000.f + i);
+  }
+
+  // f16c and scalar paths must give the same bits
+  for (auto isa : {mr::Isa::generic, mr::Isa::avx2}) {
+    if (!mr::force_isa(isa)) {
+      continue;
+    }
+    std::vector<mr::Half> halves(floats.size());
+    std::vector<float> widened(floats.size());
+    mr::convert(floats, halves);
+    mr::convert(halves, widened);
+    for (size_t i = 0; i < floats.size(); i++) {
+      EXPECT_EQ(halves[i], mr::Half(floats[i])) << isa;
+      EXPECT_EQ(widened[i], float(halves[i])) << isa;
+    }
+
+    std::vector<mr::Vec3h> hvecs(vecs.size());
+    std::vector<mr::Vec3f> back(vecs.size());
+    mr::convert(vecs, hvecs);
+    mr::convert(hvecs, back);
+    for (size_t i = 0; i < vecs.size(); i++) {
+      EXPECT_EQ(hvecs[i], mr::Vec3h(vecs[i])) << isa;
+      EXPECT_TRUE(mr::equal(back[i], vecs[i], 0.5f)) << isa;
+    }
+  }
+  mr::reset_isa();
+}
+
+TEST_F(Vector3DTest, Octahedral) {
+  // maximum angular error (in degrees) over a fibonacci sphere sweep
+  auto max_error = []<size_t Bits>(std::integral_constant<size_t, Bits>) {
+    constexpr size_t count = 1 << 16;
+    std::vector<mr::Norm3f> normals;
+    for (size_t i = 0; i < count; i++) {
+      const float z = 1 - (2 * i + 1.f) / count;
+      const float r = std::sqrt(1 - z * z);
+      const float phi = i * 2.39996323f;
+      normals.emplace_back(r * std::cos(phi), r * std::sin(phi), z);
+    }
+    std::vector<mr::OctNorm<Bits>> encoded(count);
+    std::vector<mr::Norm3f> decoded(count, mr::Norm3f(1, 0, 0));
+    mr::oct_encode(normals, encoded);
+    mr::oct_decode(encoded, decoded);
+
+    double error = 0;
+    for (size_t i = 0; i < count; i++) {
+      EXPECT_EQ(encoded[i], mr::oct_encode<Bits>(normals[i]));
+      EXPECT_TRUE(mr::equal(decoded[i], mr::oct_decode(encoded[i]), 0.00001f));
+      EXPECT_NEAR(mr::Vec3f(decoded[i]).length(), 1, 0.00001);
+      const mr::Vec3d a = mr::Vec3f(normals[i]), b = mr::Vec3f(decoded[i]);
+      error = std::max(error, std::atan2(a.cross(b).length(), a.dot(b)));
+    }
+    return error * 180 / std::numbers::pi;
+  };
+  // documented figures (octahedral.hpp)
+  EXPECT_LT(max_error(std::integral_constant<size_t, 16>{}), 0.96);
+  EXPECT_LT(max_error(std::integral_constant<size_t, 24>{}), 0.06);
+  EXPECT_LT(max_error(std::integral_constant<size_t, 32>{}), 0.004);
+
+  // axes are exact
+  for (auto axis : {mr::Norm3f(1, 0, 0), mr::Norm3f(0, -1, 0), mr::Norm3f(0, 0, -1)}) {
+    EXPECT_TRUE(mr::equal(mr::oct_decode(mr::oct_encode<16>(axis)), axis, 0.00001f));
+  }
+  EXPECT_EQ(sizeof(mr::OctNorm24), 3);
+}
+
+TEST_F(Vector3DTest, Reductions) {
+  std::vector<mr::Vec3f> points {v1, v2, {-1, 7, 0}, {2, -3, 10}, {0, 0, 0}};
+  EXPECT_EQ(mr::component_min(points), mr::Vec3f(-1, -3, 0));
+  EXPECT_EQ(mr::component_max(points), mr::Vec3f(4, 7, 10));
+  EXPECT_EQ(mr::sum(points), mr::Vec3f(6, 11, 19));
+  EXPECT_EQ(mr::mean(points), mr::Vec3f(1.2, 2.2, 3.8));
+  EXPECT_FLOAT_EQ(mr::min_length(points), 0);
+  EXPECT_FLOAT_EQ(mr::max_length(points), std::sqrt(113.f));
+
+  const mr::AABBf box = mr::bounds(points);
+  EXPECT_EQ(box.min, mr::Vec3f(-1, -3, 0));
+  EXPECT_EQ(box.max, mr::Vec3f(4, 7, 10));
+  for (const auto &p : points) {
+    EXPECT_TRUE(box.contains(p));
+  }
+  EXPECT_FALSE(box.contains(mr::Vec3f(0, 8, 0)));
+
+  // large enough to be split across threads
+  std::vector<mr::Vec3f> cloud(1 << 16);
+  for (size_t i = 0; i < cloud.size(); i++) {
+    cloud[i] = mr::Vec3f(i % 7, -float(i % 13), i % 2);
+  }
+  cloud[12345] = mr::Vec3f(-100, 50, 3);
+  const mr::AABBf cloud_box = mr::bounds(cloud, mr::parallel);
+  EXPECT_EQ(cloud_box.min, mr::Vec3f(-100, -12, 0));
+  EXPECT_EQ(cloud_box.max, mr::Vec3f(6, 50, 3));
+  EXPECT_EQ(mr::sum(cloud, mr::parallel), mr::sum(cloud));
+  EXPECT_EQ(mr::component_max(cloud, mr::parallel), cloud_box.max);
+}
+
+class VecStreamTest : public ::testing::Test {
+protected:
+  // odd size to cover the scalar tail
+  std::array<mr::Vec3f, 5> vecs {
+    mr::Vec3f{1, 2, 3},
+    mr::Vec3f{4, 5, 6},
+    mr::Vec3f{3, 4, 0},
+    mr::Vec3f{0, 0, 0},
+    mr::Vec3f{-2, 0, 0},
+  };
+  mr::VecStream3f s1 {vecs};
+};
+
+TEST_F(VecStreamTest, Conversion) {
+  EXPECT_EQ(s1.size(), vecs.size());
+  for (size_t i = 0; i < vecs.size(); i++) {
+    EXPECT_EQ(s1[i], vecs[i]);
+  }
+
+  std::array<mr::Vec3f, 5> copy;
+  s1.copy_to(copy);
+  EXPECT_EQ(copy, vecs);
+
+  // appended vectors keep the padding lanes zeroed
+  mr::VecStream3f appended;
+  for (size_t i = 0; i < 3 * vecs.size(); i++) {
+    appended.push_back(vecs[i % vecs.size()]);
+  }
+  auto normalized = s1;
+  normalized.normalize();
+  appended.normalize();
+  for (size_t i = 0; i < appended.size(); i++) {
+    EXPECT_EQ(appended[i], normalized[i % vecs.size()]);
+  }
+  EXPECT_EQ(appended.component(0).size(), appended.size());
+}
+
+TEST_F(VecStreamTest, BlockTranspose) {
+  std::array<mr::Vec4f, 9> aos;
+  for (size_t i = 0; i < aos.size(); i++) {
+    aos[i] = mr::Vec4f(i, 10.f + i, 20.f + i, 30.f + i);
+  }
+
+  const auto soa4 = mr::aos_to_soa(aos.data());
+  const auto soa8 = mr::aos_to_soa<8>(aos.data());
+  for (size_t c = 0; c < 4; c++) {
+    for (size_t i = 0; i < 8; i++) {
+      EXPECT_EQ(soa8[c][i], aos[i][c]);
+      if (i < 4) {
+        EXPECT_EQ(soa4[c][i], aos[i][c]);
+      }
+    }
+  }
+
+  std::array<mr::Vec4f, 8> back4, back8;
+  mr::soa_to_aos(soa4, back4.data());
+  mr::soa_to_aos(soa8, back8.data());
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(back8[i], aos[i]);
+    if (i < 4) {
+      EXPECT_EQ(back4[i], aos[i]);
+    }
+  }
+
+  // vec4 streams convert in blocks
+  mr::VecStream4f s4 {aos};
+  std::array<mr::Vec4f, 9> copy;
+  s4.copy_to(copy);
+  EXPECT_EQ(copy, aos);
+  EXPECT_EQ(s4[8], aos[8]);
+}
+
+TEST_F(VecStreamTest, Arithmetic) {
+  auto sum = s1 + s1;
+  auto scaled = 2.f * s1;
+  EXPECT_EQ(sum, scaled);
+  for (size_t i = 0; i < vecs.size(); i++) {
+    EXPECT_EQ(sum[i], vecs[i] + vecs[i]);
+    EXPECT_EQ((s1 * s1)[i], vecs[i] * vecs[i]);
+    EXPECT_EQ((s1 - sum)[i], -vecs[i]);
+  }
+}
+
+TEST_F(VecStreamTest, DotCross) {
+  mr::VecStream3f s2 {s1};
+  for (size_t i = 0; i < s2.size(); i++) {
+    s2.set(i, s2[i] + mr::Vec3f{1, 0, 2});
+  }
+
+  std::array<float, 5> dots;
+  s1.dot(s2, dots);
+  auto crosses = s1.cross(s2);
+  for (size_t i = 0; i < vecs.size(); i++) {
+    EXPECT_EQ(dots[i], s1[i].dot(s2[i]));
+    EXPECT_EQ(crosses[i], s1[i].cross(s2[i]));
+  }
+}
+
+TEST_F(VecStreamTest, Normalize) {
+  std::array<float, 5> lengths;
+  s1.length(lengths);
+  EXPECT_NEAR(lengths[0], std::sqrt(14.0f), 0.0001);
+  EXPECT_NEAR(lengths[2], 5, 0.0001);
+
+  auto copy = s1;
+  s1.normalize();
+  copy.normalize_fast<mr::RsqrtPrecision::newton2>();
+  for (size_t i = 0; i < vecs.size(); i++) {
+    auto expected = vecs[i];
+    expected.normalize();
+    EXPECT_TRUE(mr::equal(s1[i], expected, 0.000001));
+    EXPECT_TRUE(mr::equal(copy[i], expected, 0.01));
+  }
+}
+
+TEST_F(VecStreamTest, Dispatch) {
+  const mr::Isa detected = mr::detected_isa();
+  EXPECT_EQ(mr::active_isa(), detected);
+  EXPECT_EQ(mr::force_isa(mr::Isa::avx512), detected == mr::Isa::avx512);
+
+  const mr::Matr4f m = mr::Matr4f::rotate({1, 1, 1}, 102_deg) * mr::Matr4f::translate({30, 47, 80});
+  // every path supported by the cpu must give the same results
+  for (auto isa : {mr::Isa::generic, mr::Isa::sse42, mr::Isa::avx2, mr::Isa::avx512}) {
+    if (!mr::force_isa(isa)) {
+      continue;
+    }
+    EXPECT_EQ(mr::active_isa(), isa);
+
+    auto points = s1, directions = s1, normalized = s1;
+    points.transform_points(m);
+    directions.transform_directions(m);
+    normalized.normalize_fast<mr::RsqrtPrecision::newton2>();
+    for (size_t i = 0; i < vecs.size(); i++) {
+      EXPECT_TRUE(mr::equal(points[i], vecs[i] * m, 0.0001)) << isa;
+      EXPECT_TRUE(mr::equal(directions[i], points[i] - mr::Vec3f(0) * m, 0.0001)) << isa;
+      if (i != 3) {
+        EXPECT_TRUE(mr::equal(normalized[i], vecs[i].normalized_unchecked<mr::RsqrtPrecision::newton2>(), 0.000001)) << isa;
+      }
+    }
+    EXPECT_EQ(normalized[3], mr::Vec3f(0));
+
+    // AoS spans and color conversions go through the same dispatcher
+    std::vector<mr::Vec3f> aos(19), transformed(aos.size());
+    std::vector<mr::Color> colors(aos.size());
+    std::vector<mr::Vec4f> argb(aos.size());
+    for (size_t i = 0; i < aos.size(); i++) {
+      aos[i] = mr::Vec3f(i, -0.5f * i, 10.f + i);
+      colors[i] = mr::Color(i / 19.f, 0.5f, 1.f - i / 19.f, 0.25f);
+    }
+    mr::transform_points(aos, m, transformed);
+    mr::Color::argb(colors, argb);
+    for (size_t i = 0; i < aos.size(); i++) {
+      EXPECT_TRUE(mr::equal(transformed[i], aos[i] * m, 0.0001)) << isa;
+      EXPECT_EQ(argb[i], colors[i].argb()) << isa;
+    }
+  }
+  mr::reset_isa();
+  EXPECT_EQ(mr::active_isa(), detected);
+}
+
 class MatrixTest : public ::testing::Test {
 protected:
   mr::Matr4f m1 {
@@ -148,6 +607,19 @@ TEST_F(MatrixTest, Getters) {
   EXPECT_EQ(m1[3][3], 16.0);
 }
 
+TEST_F(MatrixTest, LoadStore) {
+  alignas(64) std::array<float, 16> buf;
+  m1.store(buf, mr::aligned);
+  for (size_t i = 0; i < buf.size(); i++) {
+    EXPECT_EQ(buf[i], i + 1);
+  }
+  EXPECT_EQ(mr::Matr4f::load(buf), m1);
+  EXPECT_EQ(mr::Matr4f::load(buf.data(), mr::aligned), m1);
+
+  m2.store(buf.data(), mr::streaming);
+  EXPECT_EQ(mr::Matr4f(buf.data(), mr::unaligned), m2);
+}
+
 TEST_F(MatrixTest, Equality) {
   mr::Matr4f copy = m1;
   EXPECT_EQ(m1, copy);
@@ -196,6 +668,344 @@ TEST_F(MatrixTest, Transposition) {
   EXPECT_EQ(copy.transpose(), expected);
 }
 
+TEST_F(MatrixTest, Determinant) {
+  EXPECT_EQ(m1.determinant(), 0);
+  EXPECT_EQ(mr::Matr4f::identity().determinant(), 1);
+  EXPECT_EQ(mr::Matr4f::scale({2, 3, 4}).determinant(), 24);
+
+  const mr::Matr4f integral {
+    2, 1, 0, 3,
+    1, 4, 2, 0,
+    0, 3, 5, 1,
+    1, 0, 2, 6
+  };
+  EXPECT_EQ(integral.determinant(), 62);
+  EXPECT_EQ(integral.determinant3(), 23);
+
+  const mr::Matr4f rigid = mr::Matr4f::rotate({1, 1, 1}, 102_deg) * mr::Matr4f::translate({30, 47, 80});
+  EXPECT_NEAR(rigid.determinant(), 1, 0.0001);
+  EXPECT_NEAR(rigid.determinant3(), 1, 0.0001);
+  EXPECT_NEAR((mr::Matr4f::scale({1, -1, 1}) * rigid).determinant3(), -1, 0.0001);
+
+  // more than one register of matrices plus a scalar tail
+  std::array<mr::Matr4f, 19> matrices;
+  for (size_t i = 0; i < matrices.size(); i++) {
+    matrices[i] = mr::Matr4f::scale({1.f + i, i % 2 ? -1.f : 1.f, 2}) * rigid;
+  }
+  std::array<float, 19> dets, dets3;
+  mr::determinant(matrices, dets);
+  mr::determinant3(matrices, dets3);
+  for (size_t i = 0; i < matrices.size(); i++) {
+    EXPECT_NEAR(dets[i], matrices[i].determinant(), 0.0001 * (1 + i));
+    EXPECT_NEAR(dets3[i], (i % 2 ? -2.f : 2.f) * (1 + i), 0.0001);
+  }
+}
+
+TEST_F(MatrixTest, MultiplyBatch) {
+  std::vector<mr::Matr4f> a(37), b(37);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = mr::Matr4f::scale({1.f + i, 2, 3}) * mr::Matr4f::translate({float(i), 1, 2});
+    b[i] = mr::Matr4f::rotate_z(mr::Radians<float>(0.1f * i));
+  }
+
+  std::vector<mr::Matr4f> out(a.size());
+  mr::multiply(a, m2, out);
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_TRUE(out[i].equal(a[i] * m2, 0.001));
+  }
+  mr::multiply(m1, b, out);
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_TRUE(out[i].equal(m1 * b[i], 0.001));
+  }
+  mr::multiply(a, b, out);
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_TRUE(out[i].equal(a[i] * b[i], 0.001));
+  }
+
+  // large enough to be split across threads
+  std::vector<mr::Matr4f> big(1 << 15, m1), big_out(big.size());
+  big[1000] = m2;
+  mr::multiply(big, m2, big_out, mr::parallel);
+  EXPECT_EQ(big_out[0], m1 * m2);
+  EXPECT_EQ(big_out[1000], m2 * m2);
+  EXPECT_EQ(big_out.back(), m1 * m2);
+
+  // in place
+  mr::multiply(a, b, a);
+  EXPECT_TRUE(a[0].equal(out[0], 0.001));
+  EXPECT_TRUE(a[36].equal(out[36], 0.001));
+}
+
+TEST_F(MatrixTest, WideKernels) {
+  std::vector<mr::Matr4f> af(19), bf(19), outf(19);
+  std::vector<mr::Matr4d> ad(19), bd(19), outd(19);
+  std::vector<mr::Vec3d> points(19), points_out(19);
+  for (size_t i = 0; i < af.size(); i++) {
+    af[i] = mr::Matr4f::scale({1.f + i, 2, 3}) * mr::Matr4f::translate({float(i), 1, 2});
+    bf[i] = mr::Matr4f::rotate_z(mr::Radians<float>(0.1f * i));
+    ad[i] = mr::Matr4d::scale({1. + i, 2, 3}) * mr::Matr4d::translate({double(i), 1, 2});
+    bd[i] = mr::Matr4d::rotate_x(mr::Radians<double>(0.1 * i));
+    points[i] = {double(i), 1, -2};
+  }
+
+  // every path supported by the cpu must match the scalar products
+  for (mr::Isa isa : {mr::Isa::generic, mr::Isa::avx2, mr::Isa::avx512}) {
+    if (not mr::force_isa(isa)) {
+      continue;
+    }
+    mr::multiply(af, bf, outf);
+    mr::multiply(ad, bd[3], outd);
+    for (size_t i = 0; i < af.size(); i++) {
+      EXPECT_TRUE(outf[i].equal(af[i] * bf[i], 0.001)) << isa;
+      EXPECT_TRUE(outd[i].equal(ad[i] * bd[3], 0.000001)) << isa;
+    }
+    mr::multiply(bf[5], af, outf);
+    EXPECT_TRUE(outf[18].equal(bf[5] * af[18], 0.001)) << isa;
+
+    mr::transform_points<double>(points, ad[7], points_out);
+    for (size_t i = 0; i < points.size(); i++) {
+      EXPECT_TRUE(points_out[i].equal(points[i] * ad[7], 0.000001)) << isa;
+    }
+    mr::transform_directions<double>(points, bd[4], points_out);
+    EXPECT_TRUE(points_out[9].equal(mr::Vec3d(mr::Vec4d(9, 1, -2, 0) * bd[4]), 0.000001)) << isa;
+
+    std::vector<mr::Vec3f> pointsf(points.size()), pointsf_out(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      pointsf[i] = mr::Vec3f(float(points[i].x()), float(points[i].y()), float(points[i].z()));
+    }
+    mr::transform_points<float>(pointsf, af[7], pointsf_out);
+    for (size_t i = 0; i < points.size(); i++) {
+      EXPECT_TRUE(pointsf_out[i].equal(pointsf[i] * af[7], 0.0001)) << isa;
+    }
+
+    mr::transpose(af, outf);
+    mr::transpose(ad, outd);
+    for (size_t i = 0; i < af.size(); i++) {
+      EXPECT_EQ(outf[i], af[i].transposed()) << isa;
+      EXPECT_EQ(outd[i], ad[i].transposed()) << isa;
+    }
+    mr::transpose(outd, outd);
+    EXPECT_EQ(outd[11], ad[11]) << isa;
+  }
+  mr::reset_isa();
+
+  EXPECT_EQ(ad[3].transposed().transposed(), ad[3]);
+  EXPECT_EQ(ad[3].transposed()[0][3], ad[3][3][0]);
+}
+
+TEST_F(MatrixTest, Inversion) {
+  const mr::Matr4f general {
+    2, 1, 0, 3,
+    1, 4, 2, 0,
+    0, 3, 5, 1,
+    1, 0, 2, 6
+  };
+  EXPECT_TRUE((general * general.inversed()).equal(mr::Matr4f::identity(), 0.0001));
+  EXPECT_TRUE((general.inversed() * general).equal(mr::Matr4f::identity(), 0.0001));
+
+  const mr::Matr4d general_d {
+    2, 1, 0, 3,
+    1, 4, 2, 0,
+    0, 3, 5, 1,
+    1, 0, 2, 6
+  };
+  EXPECT_TRUE((general_d * general_d.inversed()).equal(mr::Matr4d::identity(), 1e-12));
+
+  const mr::Matr4f rigid = mr::Matr4f::rotate({1, 1, 1}, 102_deg) * mr::Matr4f::translate({30, 47, 80});
+  const mr::Matr4f affine = mr::Matr4f::scale({2, 0.5, 3}) * rigid;
+  EXPECT_TRUE(affine.inversed_affine().equal(affine.inversed(), 0.0001));
+  EXPECT_TRUE(rigid.inversed_rigid().equal(rigid.inversed(), 0.0001));
+  EXPECT_TRUE(rigid.inversed_affine().equal(rigid.inversed_rigid(), 0.0001));
+
+  mr::Vec3f v {1, 2, 3};
+  EXPECT_TRUE(mr::equal((v * affine) * affine.inversed_affine(), v, 0.0001));
+
+  mr::Matr4f copy = rigid;
+  copy.inverse_rigid();
+  EXPECT_TRUE((copy * rigid).equal(mr::Matr4f::identity(), 0.0001));
+}
+
+TEST_F(MatrixTest, Affine) {
+  const mr::Matr4f rigid_m = mr::Matr4f::rotate({1, 1, 1}, 102_deg) * mr::Matr4f::translate({30, 47, 80});
+  const mr::Matr4f affine_m = mr::Matr4f::scale({2, 0.5, 3}) * rigid_m;
+  const mr::Affine3f rigid {rigid_m};
+  const mr::Affine3f affine {affine_m};
+
+  EXPECT_TRUE(mr::Matr4f(affine).equal(affine_m));
+  EXPECT_TRUE(mr::Matr4f(affine * rigid).equal(affine_m * rigid_m, 0.001));
+  EXPECT_TRUE(mr::Matr4f(affine.inversed()).equal(affine_m.inversed(), 0.0001));
+  EXPECT_TRUE(mr::Matr4f(rigid.inversed_rigid()).equal(rigid_m.inversed(), 0.0001));
+  EXPECT_TRUE((affine * affine.inversed()).equal(mr::Affine3f::identity(), 0.0001));
+  EXPECT_NEAR(affine.determinant(), affine_m.determinant3(), 0.0001);
+  EXPECT_EQ(affine.translation(), mr::Vec3f(affine_m[3][0], affine_m[3][1], affine_m[3][2]));
+
+  mr::Vec3f v {1, -2, 3};
+  EXPECT_TRUE(mr::equal(affine.transform_point(v), v * affine_m, 0.0001));
+  EXPECT_TRUE(mr::equal(v * affine, v * affine_m, 0.0001));
+  EXPECT_TRUE(mr::equal(affine.transform_direction(v), v * mr::Matr4f(affine_m[0], affine_m[1], affine_m[2], mr::Matr4f::RowT(0, 0, 0, 1)), 0.0001));
+
+  EXPECT_EQ(mr::Affine3f(mr::Matr4f::translate({1, 2, 3})), mr::Affine3f::translate({1, 2, 3}));
+  EXPECT_EQ(mr::Affine3f(mr::Matr4f::scale({1, 2, 3})), mr::Affine3f::scale({1, 2, 3}));
+
+  std::array<float, 12> buf;
+  affine.store(buf.data());
+  EXPECT_EQ(mr::Affine3f::load(buf.data()), affine);
+  EXPECT_EQ(buf[3], affine_m[3][0]);
+}
+
+TEST_F(MatrixTest, Hierarchy) {
+  const mr::Matr4f root_m = mr::Matr4f::rotate_y(30_deg) * mr::Matr4f::translate({1, 2, 3});
+  const mr::Matr4f arm_m = mr::Matr4f::scale({2, 2, 2}) * mr::Matr4f::translate({0, 1, 0});
+  const mr::Matr4f hand_m = mr::Matr4f::rotate_x(45_deg);
+
+  mr::Hierarchyf scene;
+  const size_t root = scene.add(root_m);
+  const size_t other = scene.add(mr::Affine3f::identity());
+  const size_t arm = scene.add(arm_m, root);
+  const size_t hand = scene.add(hand_m, arm);
+  const size_t leg = scene.add(arm_m, root);
+  EXPECT_EQ(scene.depth(hand), 2);
+  EXPECT_EQ(scene.parent(leg), root);
+
+  EXPECT_EQ(scene.update(), 5);
+  EXPECT_TRUE(mr::Matr4f(scene.world(hand)).equal(hand_m * arm_m * root_m, 0.0001));
+  EXPECT_TRUE(mr::Matr4f(scene.world(leg)).equal(arm_m * root_m, 0.0001));
+  EXPECT_EQ(scene.world(other), mr::Affine3f::identity());
+
+  // clean nodes are skipped, dirty ones update their subtree only
+  EXPECT_EQ(scene.update(), 0);
+  scene.set_local(arm, mr::Matr4f::identity());
+  EXPECT_TRUE(scene.dirty(arm));
+  EXPECT_EQ(scene.update(mr::parallel), 2);
+  EXPECT_FALSE(scene.dirty(arm));
+  EXPECT_TRUE(mr::Matr4f(scene.world(hand)).equal(hand_m * root_m, 0.0001));
+
+  // large enough to be split across threads, compared with a sequential loop
+  mr::Hierarchyf big;
+  std::vector<mr::Matr4f> reference;
+  for (size_t i = 0; i < 20000; i++) {
+    const mr::Matr4f local = mr::Matr4f::rotate_z(mr::Radians<float>(0.001f * i)) * mr::Matr4f::translate({1, 0, 0});
+    const size_t parent = i == 0 ? mr::Hierarchyf::no_parent : i / 4;
+    big.add(local, parent);
+    reference.push_back(i == 0 ? local : local * reference[parent]);
+  }
+  EXPECT_EQ(big.update(mr::parallel), 20000);
+  for (size_t i = 0; i < reference.size(); i++) {
+    EXPECT_TRUE(mr::Matr4f(big.world(i)).equal(reference[i], 0.001)) << i;
+  }
+}
+
+TEST_F(MatrixTest, Trs) {
+  // 90 degrees around x: y -> z
+  const float h = std::sqrt(0.5f);
+  const mr::Quat<float> qx {mr::Radiansf(h), h, 0, 0};
+  EXPECT_TRUE(mr::equal(mr::Vec3f(0, 1, 0) * mr::Matr4f::trs({0, 0, 0}, qx), mr::Vec3f(0, 0, 1), 0.0001));
+
+  const mr::Vec3f t {30, 47, 80}, s {2, 0.5, 3};
+  const mr::Matr4f r = mr::Matr4f::trs({0, 0, 0}, qx);
+  EXPECT_TRUE(mr::Matr4f::trs(t, qx, s).equal(mr::Matr4f::scale(s) * r * mr::Matr4f::translate(t), 0.0001));
+
+  // round trips through every branch of the quaternion conversion
+  const std::array<mr::Quat<float>, 5> rotations {
+    qx,
+    *mr::Quat<float>(mr::Radiansf(0.9), 0.1, -0.3, 0.2).normalized(),
+    *mr::Quat<float>(mr::Radiansf(0.1), 0.8, 0.3, -0.2).normalized(),
+    *mr::Quat<float>(mr::Radiansf(0.2), -0.1, 0.9, 0.3).normalized(),
+    *mr::Quat<float>(mr::Radiansf(0), 0.1, -0.2, 0.9).normalized(),
+  };
+  std::vector<mr::Trsf> trs;
+  for (const auto &q : rotations) {
+    trs.push_back({t, q, s});
+    trs.push_back({-t, q, mr::Vec3f(-1, 2, 1)});
+  }
+  for (const auto &expected : trs) {
+    const mr::Matr4f m = expected.matr();
+    mr::Trsf res = m.decompose();
+    // mirrored scale is moved to x
+    if (expected.scale.x() < 0) {
+      EXPECT_TRUE(mr::Matr4f::trs(res).equal(m, 0.0001)) << res;
+      EXPECT_LT(res.scale.x(), 0);
+    } else {
+      EXPECT_TRUE(res.equal(expected, 0.0001) || res.equal({t, mr::Quat<float>(mr::Vec4f(-mr::Vec4f(expected.rotation))), s}, 0.0001)) << res;
+    }
+  }
+
+  // shear is dropped by the orthogonalizing version
+  const mr::Matr4f sheared = mr::Matr4f {1, 0.2, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1} * trs[2].matr();
+  const mr::Trsf res = sheared.decompose<mr::DecomposeMode::orthogonalize>();
+  EXPECT_TRUE(mr::equal(mr::Vec3f(1, 0, 0) * mr::Matr4f::trs({0, 0, 0}, res.rotation),
+                        (mr::Vec3f(1, 0.2, 0) * trs[2].matr() - t).normalized().value(), 0.0001));
+
+  // batch versions match the single ones
+  std::vector<mr::Matr4f> matrices(trs.size());
+  std::vector<mr::Trsf> decomposed(trs.size());
+  mr::compose(trs, matrices);
+  mr::decompose(matrices, decomposed);
+  for (size_t i = 0; i < trs.size(); i++) {
+    EXPECT_TRUE(matrices[i].equal(trs[i].matr(), 0.0001));
+    EXPECT_TRUE(decomposed[i].equal(matrices[i].decompose(), 0.0001));
+  }
+}
+
+TEST_F(MatrixTest, NormalMatrix) {
+  const auto upper = [](const mr::Matr4f &m) {
+    return mr::Matr3f {m[0][0], m[0][1], m[0][2], m[1][0], m[1][1], m[1][2], m[2][0], m[2][1], m[2][2]};
+  };
+  const mr::Matr4f rigid = mr::Matr4f::rotate({1, 1, 1}, 102_deg) * mr::Matr4f::translate({30, 47, 80});
+  const mr::Matr4f uniform = mr::Matr4f::scale({2, 2, 2}) * rigid;
+  const mr::Matr4f general = mr::Matr4f::scale({2, 0.5, 3}) * rigid;
+  const mr::Matr4f sheared = mr::Matr4f {1, 0.2, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1} * general;
+
+  for (const mr::Matr4f &m : {rigid, uniform, general, sheared}) {
+    EXPECT_TRUE(m.normal_matrix().equal(upper(m).inversed().transposed(), 0.0001)) << m;
+  }
+  EXPECT_TRUE(uniform.normal_matrix().equal(upper(mr::Matr4f::scale({0.5, 0.5, 0.5}) * rigid), 0.0001));
+
+  // normals stay perpendicular to transformed tangents
+  const mr::Vec3f tangent {1, 1, 0}, normal {1, -1, 0.5};
+  const mr::Vec3f t = tangent * upper(sheared), n = normal * sheared.normal_matrix();
+  EXPECT_NEAR(t.dot(n), 0, 0.0001);
+
+  std::vector<mr::Matr4f> in {rigid, uniform, general, sheared};
+  std::vector<mr::Matr3f> out3(in.size());
+  std::vector<mr::Matr<float, 3, 4>> out34(in.size());
+  mr::normal_matrix(in, out3);
+  mr::normal_matrix(in, out34);
+  for (size_t i = 0; i < in.size(); i++) {
+    EXPECT_EQ(out3[i], in[i].normal_matrix());
+    EXPECT_EQ(out34[i][2], (mr::Row<float, 4>(out3[i][2][0], out3[i][2][1], out3[i][2][2], 0)));
+  }
+}
+
+TEST_F(MatrixTest, Sizes) {
+  const mr::Matr2f a {1, 2,
+                      3, 4};
+  EXPECT_EQ(a * mr::Matr2f::identity(), a);
+  EXPECT_EQ(a * a, mr::Matr2f(7, 10, 15, 22));
+  EXPECT_EQ(a.determinant(), -2);
+  EXPECT_TRUE((a * a.inversed()).equal(mr::Matr2f::identity(), 0.0001));
+  EXPECT_EQ(mr::Vec2f(1, 1) * a, mr::Vec2f(4, 6));
+  EXPECT_EQ(a * mr::Vec2f(1, 1), mr::Vec2f(3, 7));
+
+  const mr::Matr3f b {2, 1, 0,
+                      1, 4, 2,
+                      0, 3, 5};
+  EXPECT_EQ(b.determinant(), 23);
+  EXPECT_EQ(b.transposed(), mr::Matr3f(2, 1, 0, 1, 4, 3, 0, 2, 5));
+  EXPECT_TRUE((b * b.inversed()).equal(mr::Matr3f::identity(), 0.0001));
+  EXPECT_EQ(mr::Vec3f(1, 0, 1) * b, mr::Vec3f(2, 4, 5));
+
+  // rectangular
+  const mr::Matr<float, 2, 3> c {1, 2, 3,
+                                 4, 5, 6};
+  const mr::Matr<float, 3, 2> ct = c.transposed();
+  EXPECT_EQ(ct, (mr::Matr<float, 3, 2>(1, 4, 2, 5, 3, 6)));
+  EXPECT_EQ(c * ct, mr::Matr2f(14, 32, 32, 77));
+  EXPECT_EQ(ct * c, mr::Matr3f(17, 22, 27, 22, 29, 36, 27, 36, 45));
+  EXPECT_EQ(mr::Vec2f(1, 1) * c, mr::Vec3f(5, 7, 9));
+  EXPECT_EQ(c * mr::Vec3f(1, 1, 1), mr::Vec2f(6, 15));
+}
+
 TEST_F(MatrixTest, Identity) {
   mr::Matr4f expected {
     1, 0, 0, 0,
@@ -204,6 +1014,7 @@ TEST_F(MatrixTest, Identity) {
     0, 0, 0, 1
   };
   EXPECT_EQ(mr::Matr4f::identity(), expected);
+  EXPECT_EQ(mr::Matr3f::identity(), (mr::Matr3f {1, 0, 0, 0, 1, 0, 0, 0, 1}));
 }
 
 TEST_F(MatrixTest, ScaleVector) {
@@ -230,12 +1041,61 @@ TEST_F(MatrixTest, RotateBasis) {
   EXPECT_TRUE(mr::equal(mr::axis::z * mr::Matr4f::rotate_x(90_deg), mr::axis::y));
 }
 
+TEST_F(MatrixTest, RotateAxisAngle) {
+  const mr::Norm3f axis = mr::Vec3f(1, -2, 0.5).normalized().value();
+  const mr::Radiansf angle {0.7f};
+  const float co = std::cos(angle._data), si = std::sin(angle._data);
+
+  // Rodrigues formula with the orientation of Matr4::rotate
+  const mr::Matr4f m = mr::Matr4f::rotate(axis, angle);
+  mr::Vec3f v {0.3, 2, -1};
+  const mr::Vec3f n = axis;
+  const mr::Vec3f expected = v * co - n.cross(v) * si + n * n.dot(v) * (1 - co);
+  EXPECT_TRUE(mr::equal(v * m, expected, 0.0001));
+  EXPECT_TRUE((m * m.transposed()).equal(mr::Matr4f::identity(), 0.0001));
+
+  std::vector<mr::Norm3f> axes;
+  std::vector<mr::Radiansf> angles;
+  for (size_t i = 0; i < 11; i++) {
+    axes.push_back(mr::Vec3f(1.f + i, -2, 0.5f * i).normalized().value());
+    angles.push_back(mr::Radiansf(0.3f * i - 1));
+  }
+  std::vector<mr::Matr4f> out(axes.size());
+  mr::rotate(axes, angles, out);
+  for (size_t i = 0; i < axes.size(); i++) {
+    EXPECT_TRUE(out[i].equal(mr::Matr4f::rotate(axes[i], angles[i]), 0.0001));
+  }
+}
+
 TEST_F(MatrixTest, RotateVector) {
   mr::Vec3f v{30, 47, 80};
   mr::Vec3f expected{38.340427, 81.678845, 36.980571};
   EXPECT_TRUE(mr::equal(v * mr::Matr4f::rotate({1, 1, 1}, 102_deg), expected, 0.0001));
 }
 
+TEST_F(MatrixTest, TransformSpan) {
+  const mr::Matr4f m = mr::Matr4f::rotate({1, 1, 1}, 102_deg) * mr::Matr4f::translate({30, 47, 80});
+  // covers whole registers and the tail
+  std::array<mr::Vec3f, 19> in;
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = mr::Vec3f(i, 2.f * i, 1.f - i);
+  }
+
+  std::array<mr::Vec3f, 19> points, directions;
+  mr::transform_points(in, m, points);
+  mr::transform_directions(in, m, directions);
+
+  for (size_t i = 0; i < in.size(); i++) {
+    auto v = in[i];
+    EXPECT_TRUE(mr::equal(points[i], v * m, 0.001));
+    EXPECT_TRUE(mr::equal(directions[i], points[i] - mr::Vec3f(0) * m, 0.001));
+  }
+
+  // in place
+  mr::transform_points(in, m, in);
+  EXPECT_EQ(in, points);
+}
+
 class QuaternionTest : public ::testing::Test {
 protected:
   mr::Quat<float> q1 {mr::Degreesf(90), 1, 0, 0};
@@ -293,6 +1153,30 @@ TEST_F(QuaternionTest, RotateMatrix) {
   EXPECT_TRUE(mr::equal(v * q1, expected));
 }
 
+TEST_F(QuaternionTest, HamiltonProduct) {
+  const mr::Quatd a(mr::Radiansd(0.3), -1.5, 2, 0.25);
+  const mr::Quatd b(mr::Radiansd(-2), 0.5, 4, -3);
+  const mr::Quatd res = a * b;
+  const mr::Vec3d expected_vec = a.w() * b.vec() + b.w() * a.vec() + a.vec() % b.vec();
+  EXPECT_TRUE(mr::equal(res.w(), a.w() * b.w() - a.vec().dot(b.vec())));
+  EXPECT_TRUE(res.vec().equal(expected_vec));
+
+  EXPECT_TRUE((a * a.inversed()).equal(mr::Quatd(mr::Radiansd(1), 0, 0, 0)));
+  EXPECT_EQ(a.conjugated(), mr::Quatd(mr::Radiansd(0.3), 1.5, -2, -0.25));
+  EXPECT_EQ((mr::Vec4d)a, mr::Vec4d(0.3, -1.5, 2, 0.25));
+  EXPECT_EQ(mr::Quatd((mr::Vec4d)a), a);
+}
+
+TEST_F(QuaternionTest, RotateVector) {
+  const mr::Quatf a = *mr::Quatf(mr::Radiansf(0.9), 0.1, -0.3, 0.2).normalized();
+  const mr::Quatf b = *mr::Quatf(mr::Radiansf(0.2), -0.1, 0.9, 0.3).normalized();
+  mr::Vec3f v {1, -2, 3};
+  EXPECT_TRUE(a.rotate(v).equal(v * mr::Matr4f::trs({}, a), 0.0001));
+  // 'a * b' applies b first
+  EXPECT_TRUE((a * b).rotate(v).equal(a.rotate(b.rotate(v)), 0.0001));
+  EXPECT_TRUE(a.conjugated().rotate(a.rotate(v)).equal(v, 0.0001));
+}
+
 // TODO: camera tests
 
 TEST(ColorTest, Constructors) {
@@ -313,6 +1197,15 @@ TEST(ColorTest, Formats) {
   EXPECT_EQ(color.argb(), 0xFF'4C'77'CC_rgba);
   EXPECT_EQ(color.bgra(), 0xCC'77'4c'FF_rgba);
   EXPECT_EQ(color.abgr(), 0xFF'CC'77'4c_rgba);
+
+  std::array<mr::Color, 3> colors {color, 0x11'22'33'44_rgba, color};
+  std::array<mr::Vec4f, 3> out;
+  mr::Color::bgra(colors, out);
+  for (size_t i = 0; i < colors.size(); i++) {
+    EXPECT_EQ(out[i], colors[i].bgra());
+  }
+  mr::Color::argb(colors, out);
+  EXPECT_EQ(out[1], 0x44'11'22'33_rgba);
 }
 
 TEST(ColorTest, Getters) {
@@ -354,6 +1247,19 @@ TEST(ColorTest, Equality) {
   EXPECT_FALSE(equal(color1, color2));
 }
 
+TEST(ColorTest, Blending) {
+  const mr::Color black {0.f, 0.f, 0.f, 1.f};
+  const mr::Color white {1.f, 1.f, 1.f, 1.f};
+  EXPECT_EQ(mr::lerp(black, white, 0.5f), mr::Color(0.5f, 0.5f, 0.5f, 1.f));
+  EXPECT_EQ(mr::saturate(white + white), white);
+  EXPECT_EQ(mr::min(black, white), black);
+
+  std::array<mr::Color, 2> from {black, white}, to {white, black}, out;
+  mr::mix(from, to, 0.25f, out);
+  EXPECT_EQ(out[0], mr::Color(0.25f, 0.25f, 0.25f, 1.f));
+  EXPECT_EQ(out[1], mr::Color(0.75f, 0.75f, 0.75f, 1.f));
+}
+
 TEST(ColorTest, Addition) {
   // Values can exeed 1.0 (should they?)
   EXPECT_EQ(mr::Color(1.0, 0.0, 0.5, 1.0) + mr::Color(0.0, 1.0, 0.5, 1.0), mr::Color(1.0, 1.0, 1.0, 2.0));